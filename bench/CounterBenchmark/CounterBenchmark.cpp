@@ -0,0 +1,138 @@
+#include "CounterBenchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char *argv[])
+{
+    adb::CounterBenchmark benchmark(argc > 1 ? std::atoll(argv[1]) : 1 << 22);
+    return benchmark.run();
+}
+
+namespace adb
+{
+CounterBenchmark::CounterBenchmark(int64_t maxSize)
+{
+    for(int64_t size = 1 << 10; size <= maxSize; size *= 16)
+        mSizes.push_back(size);
+}
+
+void CounterBenchmark::benchmark(int64_t size)
+{
+    const std::vector<int64_t> keys = createKeys(size * 2, 1);
+    Container hash;
+
+    measure("insert", size, size, [&] {
+        for(int64_t i = 0; i < size; i++)
+            hash.insert(keys[i], i);
+    });
+
+    measure("find hit", size, size, [&] {
+        for(int64_t i = 0; i < size; i++)
+            mSink = mSink + hash.contains(keys[i]);
+    });
+
+    measure("find miss", size, size, [&] {
+        for(int64_t i = size; i < size * 2; i++)
+            mSink = mSink + hash.contains(keys[i]);
+    });
+
+    measure("remove", size, size, [&] {
+        for(int64_t i = 0; i < size; i++)
+            hash.remove(keys[i]);
+    });
+
+    hash = Container();
+    int64_t rehashes = 0;
+    int64_t moved = 0;
+    std::array<int64_t, PerfCounters::EVENT_COUNT> totals = {};
+
+    for(int64_t i = 0; i < size; i++)
+    {
+        const int64_t capacity = hash.stats().capacity;
+
+        if(capacity == 0 || hash.count() + 1 < capacity * 15 / 16)
+        {
+            hash.insert(keys[i], i);
+            continue;
+        }
+
+        mCounters.start();
+        hash.insert(keys[i], i);
+        mCounters.stop();
+
+        if(hash.stats().capacity == capacity)
+            continue;
+
+        rehashes++;
+        moved += hash.count();
+
+        for(int event = 0; event < PerfCounters::EVENT_COUNT; event++)
+            totals[event] += mCounters.value(static_cast<PerfCounters::Event>(event));
+    }
+
+    std::printf("%-10s %9lld %9lld", "rehash", static_cast<long long>(size), static_cast<long long>(rehashes));
+
+    for(int event = 0; event < PerfCounters::EVENT_COUNT; event++)
+    {
+        if(moved == 0 || !mCounters.isAvailable(static_cast<PerfCounters::Event>(event)))
+            std::printf(" %12s", "n/a");
+        else
+            std::printf(" %12.2f", static_cast<double>(totals[event]) / moved);
+    }
+
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+std::vector<int64_t> CounterBenchmark::createKeys(int64_t count, uint64_t seed)
+{
+    std::mt19937_64 generator(seed);
+    std::vector<int64_t> keys(static_cast<std::size_t>(count));
+
+    for(int64_t &key : keys)
+        key = static_cast<int64_t>(generator() >> 1);
+
+    return keys;
+}
+
+void CounterBenchmark::measure(const std::string &operation, int64_t size, int64_t operations, const std::function<void()> &body)
+{
+    mCounters.start();
+    body();
+    mCounters.stop();
+    print(operation, size, operations);
+}
+
+void CounterBenchmark::print(const std::string &operation, int64_t size, int64_t operations)
+{
+    std::printf("%-10s %9lld %9lld", operation.c_str(), static_cast<long long>(size), static_cast<long long>(operations));
+
+    for(int event = 0; event < PerfCounters::EVENT_COUNT; event++)
+    {
+        const PerfCounters::Event counter = static_cast<PerfCounters::Event>(event);
+
+        if(mCounters.isAvailable(counter) && mCounters.value(counter) >= 0)
+            std::printf(" %12.2f", static_cast<double>(mCounters.value(counter)) / operations);
+        else
+            std::printf(" %12s", "n/a");
+    }
+
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+int CounterBenchmark::run()
+{
+    if(!mCounters.isAvailable())
+        std::fprintf(stderr, "Hardware counters are not available (check /proc/sys/kernel/perf_event_paranoid).\n");
+
+    std::printf("%-10s %9s %9s %12s %12s %12s %12s %12s\n", "operation", "size", "ops", "cycles", "instructions", "L1 misses", "LLC misses", "dTLB misses");
+
+    for(int64_t size : mSizes)
+        benchmark(size);
+
+    return 0;
+}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "PerfCounters.h"
+
+#include <ADbHash.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace adb
+{
+class CounterBenchmark
+{
+public:
+    explicit CounterBenchmark(int64_t maxSize);
+
+    int run();
+
+private:
+    using Container = ADbHash<int64_t, int64_t, IntegerHash<int64_t>>;
+
+    void benchmark(int64_t size);
+    static std::vector<int64_t> createKeys(int64_t count, uint64_t seed);
+    void measure(const std::string &operation, int64_t size, int64_t operations, const std::function<void()> &body);
+    void print(const std::string &operation, int64_t size, int64_t operations);
+
+    PerfCounters mCounters;
+    std::vector<int64_t> mSizes;
+    volatile int64_t mSink = 0;
+};
+}
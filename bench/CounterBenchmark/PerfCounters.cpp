@@ -0,0 +1,110 @@
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace
+{
+#ifdef __linux__
+int openEvent(uint32_t type, uint64_t config)
+{
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+uint64_t cacheMiss(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+}
+
+namespace adb
+{
+PerfCounters::PerfCounters()
+{
+    mDescriptors.fill(-1);
+    mValues.fill(-1);
+#ifdef __linux__
+    mDescriptors[static_cast<int>(Event::Cycles)] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    mDescriptors[static_cast<int>(Event::Instructions)] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    mDescriptors[static_cast<int>(Event::L1Misses)] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D));
+    mDescriptors[static_cast<int>(Event::LLCMisses)] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+    mDescriptors[static_cast<int>(Event::TLBMisses)] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for(int descriptor : mDescriptors)
+        if(descriptor != -1)
+            close(descriptor);
+#endif
+}
+
+bool PerfCounters::isAvailable() const
+{
+    for(int descriptor : mDescriptors)
+        if(descriptor != -1)
+            return true;
+
+    return false;
+}
+
+bool PerfCounters::isAvailable(Event event) const
+{
+    return mDescriptors[static_cast<int>(event)] != -1;
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for(int descriptor : mDescriptors)
+    {
+        if(descriptor != -1)
+        {
+            ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void PerfCounters::stop()
+{
+#ifdef __linux__
+    for(int descriptor : mDescriptors)
+        if(descriptor != -1)
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+    for(int i = 0; i < EVENT_COUNT; i++)
+    {
+        int64_t count = 0;
+
+        if(mDescriptors[i] == -1 || read(mDescriptors[i], &count, sizeof(count)) != sizeof(count))
+            count = -1;
+
+        mValues[i] = count;
+    }
+#endif
+}
+
+int64_t PerfCounters::value(Event event) const
+{
+    return mValues[static_cast<int>(event)];
+}
+}
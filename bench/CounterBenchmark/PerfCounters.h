@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace adb
+{
+class PerfCounters
+{
+public:
+    enum class Event
+    {
+        Cycles,
+        Instructions,
+        L1Misses,
+        LLCMisses,
+        TLBMisses
+    };
+
+    static constexpr int EVENT_COUNT = 5;
+
+    PerfCounters();
+    PerfCounters(const PerfCounters &other) = delete;
+    ~PerfCounters();
+
+    bool isAvailable() const;
+    bool isAvailable(Event event) const;
+    PerfCounters &operator=(const PerfCounters &other) = delete;
+    void start();
+    void stop();
+    int64_t value(Event event) const;
+
+private:
+    std::array<int, EVENT_COUNT> mDescriptors;
+    std::array<int64_t, EVENT_COUNT> mValues;
+};
+}
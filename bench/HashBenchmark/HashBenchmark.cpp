@@ -0,0 +1,319 @@
+#include "HashBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+int64_t allocatedBytes = 0;
+
+template<typename T>
+class CountingAllocator
+{
+public:
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &)
+    {
+    }
+
+    T *allocate(std::size_t count)
+    {
+        allocatedBytes += static_cast<int64_t>(count * sizeof(T));
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *pointer, std::size_t count)
+    {
+        allocatedBytes -= static_cast<int64_t>(count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U> &) const
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const CountingAllocator<U> &) const
+    {
+        return false;
+    }
+};
+
+template<typename Key>
+using StdHash = std::unordered_multimap<Key, int64_t, std::hash<Key>, std::equal_to<Key>, CountingAllocator<std::pair<const Key, int64_t>>>;
+
+template<typename Key>
+using StdMap = std::unordered_map<Key, int64_t, std::hash<Key>, std::equal_to<Key>, CountingAllocator<std::pair<const Key, int64_t>>>;
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy>
+void insert(adb::Hash<Key, Value, DataType, HashFunction, KeyPolicy> &container, const Key &key, const Value &value)
+{
+    container.insert(key, value);
+}
+
+template<typename Container, typename Key, typename Value>
+void insert(Container &container, const Key &key, const Value &value)
+{
+    container.emplace(key, value);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy>
+bool contains(const adb::Hash<Key, Value, DataType, HashFunction, KeyPolicy> &container, const Key &key)
+{
+    return container.contains(key);
+}
+
+template<typename Container, typename Key>
+bool contains(const Container &container, const Key &key)
+{
+    return container.find(key) != container.end();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy>
+void remove(adb::Hash<Key, Value, DataType, HashFunction, KeyPolicy> &container, const Key &key)
+{
+    container.remove(key);
+}
+
+template<typename Container, typename Key>
+void remove(Container &container, const Key &key)
+{
+    container.erase(key);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy>
+void aggregate(adb::Hash<Key, Value, DataType, HashFunction, KeyPolicy> &container, const Key *keys, const Value *values, int64_t count)
+{
+    container.aggregate(keys, keys + count, values, std::plus<Value>());
+}
+
+template<typename Container, typename Key, typename Value>
+void aggregate(Container &container, const Key *keys, const Value *values, int64_t count)
+{
+    for(int64_t i = 0; i < count; i++)
+        container[keys[i]] += values[i];
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy>
+int64_t sum(adb::Hash<Key, Value, DataType, HashFunction, KeyPolicy> &container)
+{
+    int64_t result = 0;
+
+    for(auto it = container.begin(); it != container.end(); ++it)
+        result += it.value();
+
+    return result;
+}
+
+template<typename Container>
+int64_t sum(Container &container)
+{
+    int64_t result = 0;
+
+    for(const auto &keyValue : container)
+        result += keyValue.second;
+
+    return result;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy>
+int64_t memoryUsage(const adb::Hash<Key, Value, DataType, HashFunction, KeyPolicy> &container)
+{
+    return container.memoryUsage();
+}
+
+template<typename Container>
+int64_t memoryUsage(const Container &container)
+{
+    return static_cast<int64_t>(sizeof(container)) + allocatedBytes;
+}
+
+int64_t nanoseconds(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+}
+
+int64_t percentile(std::vector<int64_t> &samples, double fraction)
+{
+    const auto it = samples.begin() + static_cast<int64_t>(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), it, samples.end());
+    return *it;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    adb::HashBenchmark benchmark(argc > 1 ? std::atoll(argv[1]) : 1 << 22);
+    return benchmark.run();
+}
+
+namespace adb
+{
+HashBenchmark::HashBenchmark(int64_t maxSize)
+{
+    for(int64_t size = 1 << 10; size <= maxSize; size *= 16)
+        mSizes.push_back(size);
+}
+
+template<typename Container, typename Key>
+void HashBenchmark::benchmark(const std::string &container, const std::string &keys, int64_t size, const std::vector<Key> &present, const std::vector<Key> &missing)
+{
+    Result result;
+    result.container = container;
+    result.keys = keys;
+    result.size = size;
+
+    Container hash;
+    const auto fill = [&] {
+        hash = Container();
+
+        for(int64_t i = 0; i < size; i++)
+            insert(hash, present[i], i);
+    };
+
+    fill();
+    result.bytesPerElement = static_cast<double>(memoryUsage(hash)) / size;
+
+    result.operation = "insert";
+    measure(result, size, 1, [&] { hash = Container(); }, [&](int64_t i) { insert(hash, present[i], i); });
+
+    fill();
+    result.operation = "find hit";
+    measure(result, size, 1, [] {}, [&](int64_t i) { mSink = mSink + contains(hash, present[i]); });
+
+    result.operation = "find miss";
+    measure(result, size, 1, [] {}, [&](int64_t i) { mSink = mSink + contains(hash, missing[i]); });
+
+    result.operation = "erase churn";
+    measure(result, size, 1, fill, [&](int64_t i) {
+        remove(hash, present[i]);
+        insert(hash, missing[i], i);
+    });
+
+    fill();
+    result.operation = "iterate";
+    measure(result, 16, size, [] {}, [&](int64_t) { mSink = mSink + sum(hash); });
+}
+
+template<typename Container, typename Key>
+void HashBenchmark::benchmarkAggregate(const std::string &container, const std::string &keys, int64_t size, const std::vector<Key> &present)
+{
+    constexpr int64_t SLICES = 16;
+    const int64_t slice = size / SLICES;
+    const std::vector<int64_t> values(static_cast<std::size_t>(size), 1);
+
+    Result result;
+    result.container = container;
+    result.keys = keys;
+    result.size = size;
+
+    for(int64_t groups : {size, std::min<int64_t>(size, 64)})
+    {
+        std::vector<Key> rows(static_cast<std::size_t>(size));
+
+        for(int64_t i = 0; i < size; i++)
+            rows[i] = present[i % groups];
+
+        Container hash;
+        aggregate(hash, rows.data(), values.data(), size);
+        result.bytesPerElement = static_cast<double>(memoryUsage(hash)) / groups;
+
+        result.operation = groups == size ? "group-by high" : "group-by low";
+        measure(result, SLICES, slice, [&] { hash = Container(); }, [&](int64_t i) { aggregate(hash, rows.data() + i * slice, values.data() + i * slice, slice); });
+    }
+}
+
+std::vector<int64_t> HashBenchmark::createIntKeys(int64_t count, uint64_t seed)
+{
+    std::mt19937_64 generator(seed);
+    std::vector<int64_t> keys(static_cast<std::size_t>(count));
+
+    for(int64_t &key : keys)
+        key = static_cast<int64_t>(generator() >> 1);
+
+    return keys;
+}
+
+std::vector<std::string> HashBenchmark::createStringKeys(int64_t count, uint64_t seed)
+{
+    std::vector<std::string> keys;
+    keys.reserve(static_cast<std::size_t>(count));
+
+    for(int64_t key : createIntKeys(count, seed))
+        keys.push_back("key-" + std::to_string(key));
+
+    return keys;
+}
+
+void HashBenchmark::measure(Result result, int64_t operations, int64_t batch, const std::function<void()> &setup, const std::function<void(int64_t)> &operation)
+{
+    setup();
+    const auto begin = std::chrono::steady_clock::now();
+
+    for(int64_t i = 0; i < operations; i++)
+        operation(i);
+
+    result.throughput = static_cast<double>(operations * batch) / std::max<int64_t>(nanoseconds(begin, std::chrono::steady_clock::now()), 1) * 1000;
+
+    std::vector<int64_t> samples(static_cast<std::size_t>(operations));
+    setup();
+
+    for(int64_t i = 0; i < operations; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        operation(i);
+        samples[i] = nanoseconds(start, std::chrono::steady_clock::now()) / batch;
+    }
+
+    result.max = *std::max_element(samples.begin(), samples.end());
+    result.p999 = percentile(samples, 0.999);
+    result.p99 = percentile(samples, 0.99);
+    result.p50 = percentile(samples, 0.5);
+    print(result);
+}
+
+void HashBenchmark::print(const Result &result)
+{
+    std::printf("%-18s %-6s %9lld %-12s %10.2f %8lld %8lld %8lld %10lld %10.1f\n", result.container.c_str(), result.keys.c_str(), static_cast<long long>(result.size), result.operation.c_str(), result.throughput, static_cast<long long>(result.p50), static_cast<long long>(result.p99), static_cast<long long>(result.p999), static_cast<long long>(result.max), result.bytesPerElement);
+    std::fflush(stdout);
+}
+
+int HashBenchmark::run()
+{
+    std::printf("%-18s %-6s %9s %-12s %10s %8s %8s %8s %10s %10s\n", "container", "keys", "size", "operation", "Mops/s", "p50 ns", "p99 ns", "p99.9 ns", "max ns", "bytes/elem");
+
+    for(int64_t size : mSizes)
+    {
+        const std::vector<int64_t> intKeys = createIntKeys(size * 2, 1);
+        const std::vector<int64_t> presentInts(intKeys.begin(), intKeys.begin() + size);
+        const std::vector<int64_t> missingInts(intKeys.begin() + size, intKeys.end());
+
+        benchmark<ADbHash<int64_t, int64_t, IntegerHash<int64_t>>>("ADbHash", "int", size, presentInts, missingInts);
+        benchmark<StdHash<int64_t>>("unordered_multimap", "int", size, presentInts, missingInts);
+        benchmark<ADbMap<int64_t, int64_t, IntegerHash<int64_t>>>("ADbMap", "int", size, presentInts, missingInts);
+        benchmark<StdMap<int64_t>>("unordered_map", "int", size, presentInts, missingInts);
+        benchmarkAggregate<ADbMap<int64_t, int64_t, IntegerHash<int64_t>>>("ADbMap", "int", size, presentInts);
+        benchmarkAggregate<StdMap<int64_t>>("unordered_map", "int", size, presentInts);
+
+        const std::vector<std::string> stringKeys = createStringKeys(size * 2, 2);
+        const std::vector<std::string> presentStrings(stringKeys.begin(), stringKeys.begin() + size);
+        const std::vector<std::string> missingStrings(stringKeys.begin() + size, stringKeys.end());
+
+        benchmark<ADbHash<std::string, int64_t, StringHash>>("ADbHash", "string", size, presentStrings, missingStrings);
+        benchmark<StdHash<std::string>>("unordered_multimap", "string", size, presentStrings, missingStrings);
+        benchmark<ADbMap<std::string, int64_t, StringHash>>("ADbMap", "string", size, presentStrings, missingStrings);
+        benchmark<StdMap<std::string>>("unordered_map", "string", size, presentStrings, missingStrings);
+    }
+
+    return 0;
+}
+}
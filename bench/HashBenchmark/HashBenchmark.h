@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ADbHash.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace adb
+{
+class HashBenchmark
+{
+public:
+    struct Result
+    {
+        std::string container;
+        std::string keys;
+        int64_t size = 0;
+        std::string operation;
+        double throughput = 0;
+        int64_t p50 = 0;
+        int64_t p99 = 0;
+        int64_t p999 = 0;
+        int64_t max = 0;
+        double bytesPerElement = 0;
+    };
+
+    explicit HashBenchmark(int64_t maxSize);
+
+    int run();
+
+private:
+    template<typename Container, typename Key>
+    void benchmark(const std::string &container, const std::string &keys, int64_t size, const std::vector<Key> &present, const std::vector<Key> &missing);
+    template<typename Container, typename Key>
+    void benchmarkAggregate(const std::string &container, const std::string &keys, int64_t size, const std::vector<Key> &present);
+    static std::vector<int64_t> createIntKeys(int64_t count, uint64_t seed);
+    static std::vector<std::string> createStringKeys(int64_t count, uint64_t seed);
+    void measure(Result result, int64_t operations, int64_t batch, const std::function<void()> &setup, const std::function<void(int64_t)> &operation);
+    static void print(const Result &result);
+
+    std::vector<int64_t> mSizes;
+    volatile int64_t mSink = 0;
+};
+}
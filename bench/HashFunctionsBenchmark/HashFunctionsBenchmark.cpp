@@ -0,0 +1,57 @@
+#include "HashFunctionsBenchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+int main()
+{
+    adb::HashFunctionsBenchmark benchmark;
+    return benchmark.run();
+}
+
+namespace adb
+{
+void HashFunctionsBenchmark::measure(const std::string &function, int64_t size, int64_t operations, const std::function<uint64_t(int64_t)> &hash)
+{
+    uint64_t result = 0;
+    const auto begin = std::chrono::steady_clock::now();
+
+    for(int64_t i = 0; i < operations; i++)
+        result ^= hash(i);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    mSink = mSink ^ result;
+    std::printf("%-20s %6lld %12.2f %12.2f\n", function.c_str(), static_cast<long long>(size), seconds * 1e9 / operations, size * operations / seconds / 1e9);
+}
+
+int HashFunctionsBenchmark::run()
+{
+    constexpr int64_t operations = 1 << 24;
+    constexpr int64_t keys = 1 << 10;
+
+    std::printf("%-20s %6s %12s %12s\n", "function", "bytes", "ns/hash", "GB/s");
+
+    measure("IdentityHash", 8, operations, [](int64_t i) { return static_cast<uint64_t>(IdentityHash<int64_t>(i)); });
+    measure("IntegerHash", 8, operations, [](int64_t i) { return static_cast<uint64_t>(IntegerHash<int64_t>(i)); });
+    measure("std::hash<int64_t>", 8, operations, [](int64_t i) { return static_cast<uint64_t>(std::hash<int64_t>()(i)); });
+
+    std::mt19937_64 generator(1);
+
+    for(int64_t size : {4, 8, 16, 32, 64, 256, 1024, 4096})
+    {
+        std::vector<std::string> strings(keys);
+
+        for(std::string &string : strings)
+            for(int64_t i = 0; i < size; i++)
+                string.push_back(static_cast<char>(generator()));
+
+        const int64_t count = operations / std::max<int64_t>(size / 16, 1);
+
+        measure("StringHash", size, count, [&](int64_t i) { return static_cast<uint64_t>(StringHash(strings[i & (keys - 1)])); });
+        measure("std::hash<string>", size, count, [&](int64_t i) { return static_cast<uint64_t>(std::hash<std::string>()(strings[i & (keys - 1)])); });
+    }
+
+    return 0;
+}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ADbHash.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace adb
+{
+class HashFunctionsBenchmark
+{
+public:
+    int run();
+
+private:
+    void measure(const std::string &function, int64_t size, int64_t operations, const std::function<uint64_t(int64_t)> &hash);
+
+    volatile uint64_t mSink = 0;
+};
+}
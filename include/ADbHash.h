@@ -1,7 +1,15 @@
 #pragma once
 
 #include "adb/BitMask.h"
+#include "adb/BloomFilter.h"
 #include "adb/Data.h"
+#include "adb/DataTraits.h"
 #include "adb/Example.h"
+#include "adb/FrozenHash.h"
 #include "adb/Hash.h"
+#include "adb/HashFunctions.h"
+#include "adb/KeyPolicy.h"
+#include "adb/ProbePolicy.h"
 #include "adb/Reference.h"
+#include "adb/StaticHash.h"
+#include "adb/Statistics.h"
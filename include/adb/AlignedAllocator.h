@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace adb
+{
+template<typename T, std::size_t Alignment>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &other);
+
+    T *allocate(std::size_t count);
+    void deallocate(T *data, std::size_t count);
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &other) const;
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &other) const;
+
+private:
+    static_assert(Alignment >= sizeof(void *) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two of at least pointer size");
+};
+
+template<typename T, std::size_t Alignment>
+template<typename U>
+AlignedAllocator<T, Alignment>::AlignedAllocator(const AlignedAllocator<U, Alignment> &other)
+{
+    (void)other;
+}
+
+template<typename T, std::size_t Alignment>
+T *AlignedAllocator<T, Alignment>::allocate(std::size_t count)
+{
+    char *data = static_cast<char *>(::operator new(count * sizeof(T) + Alignment + sizeof(void *)));
+    char *aligned = data + sizeof(void *);
+    aligned += Alignment - reinterpret_cast<std::uintptr_t>(aligned) % Alignment;
+    reinterpret_cast<void **>(aligned)[-1] = data;
+    return reinterpret_cast<T *>(aligned);
+}
+
+template<typename T, std::size_t Alignment>
+void AlignedAllocator<T, Alignment>::deallocate(T *data, std::size_t count)
+{
+    (void)count;
+    ::operator delete(reinterpret_cast<void **>(data)[-1]);
+}
+
+template<typename T, std::size_t Alignment>
+template<typename U>
+bool AlignedAllocator<T, Alignment>::operator==(const AlignedAllocator<U, Alignment> &other) const
+{
+    (void)other;
+    return true;
+}
+
+template<typename T, std::size_t Alignment>
+template<typename U>
+bool AlignedAllocator<T, Alignment>::operator!=(const AlignedAllocator<U, Alignment> &other) const
+{
+    return !(*this == other);
+}
+}
@@ -3,6 +3,10 @@
 #include <bitset>
 #include <iterator>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace adb
 {
 template<typename T>
@@ -20,6 +24,7 @@ public:
 private:
     friend class BitMask<T>::const_iterator;
 
+    static int countTrailingZeros(unsigned long long data);
     int findNext(int index) const;
 
     const std::bitset<sizeof(T) * CHAR_BIT> mData;
@@ -113,10 +118,34 @@ bool BitMask<T>::const_iterator::operator!=(const_iterator other) const
 }
 
 template<typename T>
-int BitMask<T>::findNext(int index) const
+int BitMask<T>::countTrailingZeros(unsigned long long data)
 {
-    while(++index < mData.size() && !mData[index])
-        ;
+#if defined(__GNUC__)
+    return __builtin_ctzll(data);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, data);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while(!(data & 1))
+    {
+        data >>= 1;
+        index++;
+    }
     return index;
+#endif
+}
+
+template<typename T>
+int BitMask<T>::findNext(int index) const
+{
+    const int size = static_cast<int>(mData.size());
+
+    if(++index >= size)
+        return size;
+
+    const unsigned long long rest = mData.to_ullong() >> index;
+    return rest == 0 ? size : index + countTrailingZeros(rest);
 }
 }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "AlignedAllocator.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace adb
+{
+class BloomFilter
+{
+public:
+    BloomFilter() = default;
+    explicit BloomFilter(int64_t bitsPerElement);
+
+    int64_t bitsPerElement() const;
+    bool contains(uint64_t hash) const;
+    int64_t count() const;
+    void insert(uint64_t hash);
+    bool isEnabled() const;
+    bool isFull() const;
+    int64_t memoryUsage() const;
+    void reset(int64_t size);
+    int64_t size() const;
+
+private:
+    static constexpr int64_t BLOCK_BITS = 512;
+    static constexpr int64_t BLOCK_WORDS = BLOCK_BITS / 64;
+
+    int64_t blockIndex(uint64_t hash) const;
+    static uint64_t mask(uint64_t hash, int64_t word);
+    static uint64_t mix(uint64_t hash);
+
+    int64_t mBitsPerElement = 0;
+    int64_t mCount = 0;
+    int64_t mSize = 0;
+    std::vector<uint64_t, AlignedAllocator<uint64_t, 64>> mWords;
+};
+
+inline BloomFilter::BloomFilter(int64_t bitsPerElement) :
+    mBitsPerElement(bitsPerElement > 0 ? bitsPerElement : 0)
+{
+}
+
+inline int64_t BloomFilter::bitsPerElement() const
+{
+    return mBitsPerElement;
+}
+
+inline bool BloomFilter::contains(uint64_t hash) const
+{
+    if(mWords.empty())
+        return true;
+
+    const uint64_t mixed = mix(hash);
+    const uint64_t *block = &mWords[static_cast<size_t>(blockIndex(mixed) * BLOCK_WORDS)];
+
+    for(int64_t word = 0; word < BLOCK_WORDS; word++)
+        if((block[word] & mask(mixed, word)) == 0)
+            return false;
+
+    return true;
+}
+
+inline int64_t BloomFilter::count() const
+{
+    return mCount;
+}
+
+inline void BloomFilter::insert(uint64_t hash)
+{
+    if(mWords.empty())
+        return;
+
+    const uint64_t mixed = mix(hash);
+    uint64_t *block = &mWords[static_cast<size_t>(blockIndex(mixed) * BLOCK_WORDS)];
+
+    for(int64_t word = 0; word < BLOCK_WORDS; word++)
+        block[word] |= mask(mixed, word);
+
+    mCount++;
+}
+
+inline bool BloomFilter::isEnabled() const
+{
+    return mBitsPerElement != 0;
+}
+
+inline bool BloomFilter::isFull() const
+{
+    return isEnabled() && mCount > mSize;
+}
+
+inline int64_t BloomFilter::memoryUsage() const
+{
+    return static_cast<int64_t>(mWords.size() * sizeof(uint64_t));
+}
+
+inline void BloomFilter::reset(int64_t size)
+{
+    mCount = 0;
+    mSize = isEnabled() ? size : 0;
+    mWords.assign(static_cast<size_t>((mSize * mBitsPerElement + BLOCK_BITS - 1) / BLOCK_BITS * BLOCK_WORDS), 0);
+}
+
+inline int64_t BloomFilter::size() const
+{
+    return mSize;
+}
+
+inline int64_t BloomFilter::blockIndex(uint64_t hash) const
+{
+    return static_cast<int64_t>((hash >> 32) * (mWords.size() / BLOCK_WORDS) >> 32);
+}
+
+inline uint64_t BloomFilter::mask(uint64_t hash, int64_t word)
+{
+    static constexpr uint32_t SALTS[BLOCK_WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+    return uint64_t(1) << ((static_cast<uint32_t>(hash) * SALTS[word]) >> 26);
+}
+
+inline uint64_t BloomFilter::mix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    return hash ^ (hash >> 33);
+}
+}
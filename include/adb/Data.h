@@ -1,5 +1,8 @@
 #pragma once
 
+#include "AlignedAllocator.h"
+#include "SIMD.h"
+
 #include <cstdint>
 #include <vector>
 
@@ -13,16 +16,21 @@ public:
 
     int64_t count() const;
     int64_t dataSize() const;
+    int64_t deletedCount() const;
     Key key(int64_t index) const;
     const char *metaData(int64_t index, int64_t size) const;
     int64_t metaSize() const;
+    void prefetch(int64_t index) const;
+    void prefetchMetaData(int64_t index) const;
     void resize(int64_t dataSize, int64_t metaSize, char metaValue);
     void setCount(int64_t count);
     void setData(int64_t index, const Key &key, const Value &value);
+    void setDeletedCount(int64_t count);
     void setMetaData(int64_t index, const std::vector<char> &values);
     void setMetaValue(int64_t index, char value);
     void setValue(int64_t index, const Value &value);
     Value value(int64_t index) const;
+    Value *valueData(int64_t index);
 
 private:
     struct Node
@@ -32,8 +40,9 @@ private:
     };
 
     int64_t mCount = 0;
+    int64_t mDeletedCount = 0;
     std::vector<Node> mData;
-    std::vector<char> mMetaData;
+    std::vector<char, AlignedAllocator<char, 64>> mMetaData;
 };
 
 template<typename Key, typename Value>
@@ -55,6 +64,12 @@ int64_t Data<Key, Value>::dataSize() const
     return static_cast<int64_t>(mData.size());
 }
 
+template<typename Key, typename Value>
+int64_t Data<Key, Value>::deletedCount() const
+{
+    return mDeletedCount;
+}
+
 template<typename Key, typename Value>
 Key Data<Key, Value>::key(int64_t index) const
 {
@@ -74,6 +89,18 @@ int64_t Data<Key, Value>::metaSize() const
     return static_cast<int64_t>(mMetaData.size());
 }
 
+template<typename Key, typename Value>
+void Data<Key, Value>::prefetch(int64_t index) const
+{
+    adb::prefetch(reinterpret_cast<const char *>(&mData[index]));
+}
+
+template<typename Key, typename Value>
+void Data<Key, Value>::prefetchMetaData(int64_t index) const
+{
+    adb::prefetch(metaData(index, 1));
+}
+
 template<typename Key, typename Value>
 void Data<Key, Value>::resize(int64_t dataSize, int64_t metaSize, char metaValue)
 {
@@ -93,6 +120,12 @@ void Data<Key, Value>::setData(int64_t index, const Key &key, const Value &value
     mData[index] = Node{key, value};
 }
 
+template<typename Key, typename Value>
+void Data<Key, Value>::setDeletedCount(int64_t count)
+{
+    mDeletedCount = count;
+}
+
 template<typename Key, typename Value>
 void Data<Key, Value>::setMetaData(int64_t index, const std::vector<char> &values)
 {
@@ -116,4 +149,10 @@ Value Data<Key, Value>::value(int64_t index) const
 {
     return mData[index].value;
 }
+
+template<typename Key, typename Value>
+Value *Data<Key, Value>::valueData(int64_t index)
+{
+    return &mData[index].value;
+}
 }
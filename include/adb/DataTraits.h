@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace adb
+{
+template<typename Data, typename = void>
+struct HasMemoryUsage : std::false_type
+{
+};
+
+template<typename Data>
+struct HasMemoryUsage<Data, decltype(void(std::declval<const Data &>().memoryUsage()))> : std::true_type
+{
+};
+
+template<typename Data, typename = void>
+struct HasPrefetch : std::false_type
+{
+};
+
+template<typename Data>
+struct HasPrefetch<Data, decltype(void(std::declval<const Data &>().prefetch(int64_t())))> : std::true_type
+{
+};
+
+template<typename Data, typename = void>
+struct HasPrefetchMetaData : std::false_type
+{
+};
+
+template<typename Data>
+struct HasPrefetchMetaData<Data, decltype(void(std::declval<const Data &>().prefetchMetaData(int64_t())))> : std::true_type
+{
+};
+
+template<typename Data, typename = void>
+struct HasValueData : std::false_type
+{
+};
+
+template<typename Data>
+struct HasValueData<Data, decltype(void(std::declval<Data &>().valueData(int64_t())))> : std::true_type
+{
+};
+}
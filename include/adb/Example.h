@@ -31,7 +31,11 @@ IdentityHash<Value>::operator uint64_t() const
 
 template<typename Key, typename Value, typename HashFunction = adb::IdentityHash<Key>>
 using ADbHash = Hash<Key, Value, Data<Key, Value>, HashFunction>;
+
+template<typename Key, typename Value, typename HashFunction = adb::IdentityHash<Key>>
+using ADbMap = Hash<Key, Value, Data<Key, Value>, HashFunction, UniqueKey>;
 #ifdef Q_CLANG_QDOC
 typedef void ADbHash;
+typedef void ADbMap;
 #endif
 }
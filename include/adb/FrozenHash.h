@@ -0,0 +1,261 @@
+#pragma once
+
+#include "BitMask.h"
+#include "HashFunctions.h"
+#include "SIMD.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace adb
+{
+template<typename Key, typename Value, typename HashFunction>
+class FrozenHash
+{
+public:
+    using const_iterator = typename std::vector<std::pair<Key, Value>>::const_iterator;
+
+    FrozenHash() = default;
+    explicit FrozenHash(std::vector<std::pair<Key, Value>> data);
+    FrozenHash(std::vector<std::pair<Key, Value>> data, const HashFunction &hashFunction);
+
+    const_iterator begin() const;
+    bool contains(const Key &key) const;
+    bool contains(const Key &key, const Value &value) const;
+    int64_t count() const;
+    int64_t count(const Key &key) const;
+    const_iterator end() const;
+    const_iterator find(const Key &key) const;
+    const_iterator find(const Key &key, const Value &value) const;
+    const HashFunction &hashFunction() const;
+    bool isEmpty() const;
+    int64_t memoryUsage() const;
+    Value value(const Key &key, const Value &defaultValue = Value()) const;
+    std::vector<Value> values(const Key &key) const;
+
+private:
+    struct NoHashFunction
+    {
+    };
+
+    using HashFunctionType = typename std::conditional<IsStatefulHash<HashFunction, Key>::value, HashFunction, NoHashFunction>::type;
+
+    void build();
+    template<typename Comparator>
+    int64_t findIndex(const Key &key, Comparator compare) const;
+    uint64_t hashKey(const Key &key) const;
+    uint64_t hashKey(const Key &key, std::false_type) const;
+    uint64_t hashKey(const Key &key, std::true_type) const;
+    int64_t homeIndex(uint64_t hash) const;
+    static char hashTag(uint64_t hash);
+
+    static constexpr int64_t GROUP_SIZE = 16;
+    static constexpr int64_t HOME_SIZE = 8;
+    static constexpr char EMPTY_TAG = static_cast<char>(0b10000000);
+    std::vector<std::pair<Key, Value>> mData;
+    std::vector<uint32_t> mOffsets = std::vector<uint32_t>(2, 0);
+    std::vector<char> mTags = std::vector<char>(GROUP_SIZE, EMPTY_TAG);
+    HashFunctionType mHashFunction;
+};
+
+template<typename Key, typename Value, typename HashFunction>
+constexpr int64_t FrozenHash<Key, Value, HashFunction>::GROUP_SIZE;
+
+template<typename Key, typename Value, typename HashFunction>
+constexpr int64_t FrozenHash<Key, Value, HashFunction>::HOME_SIZE;
+
+template<typename Key, typename Value, typename HashFunction>
+constexpr char FrozenHash<Key, Value, HashFunction>::EMPTY_TAG;
+
+template<typename Key, typename Value, typename HashFunction>
+FrozenHash<Key, Value, HashFunction>::FrozenHash(std::vector<std::pair<Key, Value>> data) :
+    mData(std::move(data))
+{
+    build();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+FrozenHash<Key, Value, HashFunction>::FrozenHash(std::vector<std::pair<Key, Value>> data, const HashFunction &hashFunction) :
+    mData(std::move(data)),
+    mHashFunction(hashFunction)
+{
+    build();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+auto FrozenHash<Key, Value, HashFunction>::begin() const -> const_iterator
+{
+    return mData.cbegin();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+bool FrozenHash<Key, Value, HashFunction>::contains(const Key &key) const
+{
+    return find(key) != end();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+bool FrozenHash<Key, Value, HashFunction>::contains(const Key &key, const Value &value) const
+{
+    return find(key, value) != end();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+int64_t FrozenHash<Key, Value, HashFunction>::count() const
+{
+    return static_cast<int64_t>(mData.size());
+}
+
+template<typename Key, typename Value, typename HashFunction>
+int64_t FrozenHash<Key, Value, HashFunction>::count(const Key &key) const
+{
+    int64_t result = 0;
+    findIndex(key, [&](int64_t index) {
+        result += mData[index].first == key;
+        return false;
+    });
+    return result;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+auto FrozenHash<Key, Value, HashFunction>::end() const -> const_iterator
+{
+    return mData.cend();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+auto FrozenHash<Key, Value, HashFunction>::find(const Key &key) const -> const_iterator
+{
+    return begin() + findIndex(key, [&](int64_t index) { return mData[index].first == key; });
+}
+
+template<typename Key, typename Value, typename HashFunction>
+auto FrozenHash<Key, Value, HashFunction>::find(const Key &key, const Value &value) const -> const_iterator
+{
+    return begin() + findIndex(key, [&](int64_t index) { return mData[index].first == key && mData[index].second == value; });
+}
+
+template<typename Key, typename Value, typename HashFunction>
+const HashFunction &FrozenHash<Key, Value, HashFunction>::hashFunction() const
+{
+    return mHashFunction;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+bool FrozenHash<Key, Value, HashFunction>::isEmpty() const
+{
+    return mData.empty();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+int64_t FrozenHash<Key, Value, HashFunction>::memoryUsage() const
+{
+    return static_cast<int64_t>(sizeof(*this) + mData.capacity() * sizeof(std::pair<Key, Value>) + mOffsets.capacity() * sizeof(uint32_t) + mTags.capacity());
+}
+
+template<typename Key, typename Value, typename HashFunction>
+Value FrozenHash<Key, Value, HashFunction>::value(const Key &key, const Value &defaultValue) const
+{
+    const const_iterator it = find(key);
+    return it != end() ? it->second : defaultValue;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+std::vector<Value> FrozenHash<Key, Value, HashFunction>::values(const Key &key) const
+{
+    std::vector<Value> vals;
+    findIndex(key, [&](int64_t index) {
+        if(mData[index].first == key)
+            vals.push_back(mData[index].second);
+
+        return false;
+    });
+    return vals;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void FrozenHash<Key, Value, HashFunction>::build()
+{
+    const int64_t size = count();
+    const int64_t homes = size / HOME_SIZE + 1;
+    std::vector<uint64_t> hashes(mData.size());
+    mOffsets.assign(static_cast<size_t>(homes + 1), 0);
+
+    for(int64_t index = 0; index < size; index++)
+    {
+        hashes[index] = hashKey(mData[index].first);
+        mOffsets[homeIndex(hashes[index]) + 1]++;
+    }
+
+    for(int64_t home = 0; home < homes; home++)
+        mOffsets[home + 1] += mOffsets[home];
+
+    std::vector<uint32_t> positions(mOffsets.begin(), mOffsets.end() - 1);
+    std::vector<std::pair<Key, Value>> data(mData.size());
+    mTags.assign(static_cast<size_t>(size + GROUP_SIZE), EMPTY_TAG);
+
+    for(int64_t index = 0; index < size; index++)
+    {
+        const uint32_t position = positions[homeIndex(hashes[index])]++;
+        data[position] = std::move(mData[index]);
+        mTags[position] = hashTag(hashes[index]);
+    }
+
+    mData = std::move(data);
+}
+
+template<typename Key, typename Value, typename HashFunction>
+template<typename Comparator>
+int64_t FrozenHash<Key, Value, HashFunction>::findIndex(const Key &key, Comparator compare) const
+{
+    const uint64_t hash = hashKey(key);
+    const int64_t home = homeIndex(hash);
+    const int64_t last = mOffsets[home + 1];
+    const char tag = hashTag(hash);
+
+    for(int64_t index = mOffsets[home]; index < last; index += GROUP_SIZE)
+    {
+        const int remaining = static_cast<int>(std::min<int64_t>(last - index, GROUP_SIZE));
+        const uint16_t mask = static_cast<uint16_t>(match(tag, &mTags[index]) & ((1 << remaining) - 1));
+
+        for(int i : BitMask<uint16_t>(mask))
+            if(compare(index + i))
+                return index + i;
+    }
+
+    return count();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+uint64_t FrozenHash<Key, Value, HashFunction>::hashKey(const Key &key) const
+{
+    return hashKey(key, IsStatefulHash<HashFunction, Key>());
+}
+
+template<typename Key, typename Value, typename HashFunction>
+uint64_t FrozenHash<Key, Value, HashFunction>::hashKey(const Key &key, std::false_type) const
+{
+    return HashFunction(key);
+}
+
+template<typename Key, typename Value, typename HashFunction>
+uint64_t FrozenHash<Key, Value, HashFunction>::hashKey(const Key &key, std::true_type) const
+{
+    return mHashFunction(key);
+}
+
+template<typename Key, typename Value, typename HashFunction>
+char FrozenHash<Key, Value, HashFunction>::hashTag(uint64_t hash)
+{
+    return static_cast<char>((hash ^ hash >> 57) & 0b01111111);
+}
+
+template<typename Key, typename Value, typename HashFunction>
+int64_t FrozenHash<Key, Value, HashFunction>::homeIndex(uint64_t hash) const
+{
+    return static_cast<int64_t>(hash % static_cast<uint64_t>(mOffsets.size() - 1));
+}
+}
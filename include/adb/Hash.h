@@ -1,28 +1,49 @@
 #pragma once
 
+#include "AlignedAllocator.h"
 #include "BitMask.h"
+#include "BloomFilter.h"
+#include "DataTraits.h"
+#include "FrozenHash.h"
+#include "HashFunctions.h"
+#include "KeyPolicy.h"
+#include "ProbePolicy.h"
 #include "Reference.h"
 #include "SIMD.h"
+#include "Statistics.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace adb
 {
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy = MultiKey, typename ProbePolicy = LinearProbe>
 class Hash
 {
 public:
     template<typename ValueType, typename ReferenceType, typename HashType>
     class iterator_base;
+    template<typename ValueType, typename ReferenceType, typename HashType>
+    class key_iterator_base;
 
     using iterator = iterator_base<Value, Reference<Value, DataType>, Hash>;
     using const_iterator = iterator_base<const Value, const Reference<const Value, const DataType>, const Hash>;
+    using key_iterator = key_iterator_base<Value, Reference<Value, DataType>, Hash>;
+    using const_key_iterator = key_iterator_base<const Value, const Reference<const Value, const DataType>, const Hash>;
 
     template<typename... T>
     Hash(T... args);
+    Hash(const Hash &other);
+    Hash(Hash &&other);
 
+    template<typename KeyIterator, typename ValueIterator, typename Combiner>
+    void aggregate(KeyIterator firstKey, KeyIterator lastKey, ValueIterator firstValue, Combiner combine);
     iterator begin();
     const_iterator cbegin() const;
     const_iterator cend() const;
@@ -33,24 +54,61 @@ public:
     int64_t count(const Key &key) const;
     int64_t count(const Key &key, const Value &value) const;
     iterator end();
+    std::pair<const_key_iterator, const_key_iterator> equal_range(const Key &key) const;
+    std::pair<key_iterator, key_iterator> equal_range(const Key &key);
     const_iterator erase(const_iterator it);
     iterator erase(iterator it);
+    template<typename Predicate>
+    int64_t erase_if(Predicate predicate);
+    const BloomFilter &filter() const;
     const_iterator find(const Key &key) const;
     const_iterator find(const Key &key, const Value &value) const;
     iterator find(const Key &key);
     iterator find(const Key &key, const Value &value);
+    template<typename Iterator, typename Callback>
+    void find(Iterator first, Iterator last, Callback callback, int64_t depth = BATCH_SIZE) const;
+    FrozenHash<Key, Value, HashFunction> freeze() const;
+    const HashFunction &hashFunction() const;
     iterator insert(const Key &key, const Value &value);
+    std::pair<iterator, bool> insert_or_assign(const Key &key, const Value &value);
     bool isEmpty() const;
+    int64_t limit() const;
+    template<typename OtherValue, typename OtherData, typename OtherHashFunction, typename OtherKeyPolicy, typename OtherProbePolicy, typename Callback>
+    void join(const Hash<Key, OtherValue, OtherData, OtherHashFunction, OtherKeyPolicy, OtherProbePolicy> &other, Callback callback, int64_t part = 0, int64_t parts = 1) const;
+    template<typename Iterator, typename Callback>
+    void join(Iterator first, Iterator last, Callback callback) const;
+    int64_t memoryUsage() const;
+    void merge(const Hash &other);
+    void merge(Hash &&other);
+    template<typename Function>
+    int64_t modify(const Key &key, Function function);
+    Hash &operator=(const Hash &other);
+    Hash &operator=(Hash &&other);
     Reference<Value, DataType> operator[](const Key &key);
     Value operator[](const Key &key) const;
     int64_t replace(const Key &key, const Value &newValue);
     int64_t replace(const Key &key, const Value &oldValue, const Value &newValue);
     int64_t remove(const Key &key);
     int64_t remove(const Key &key, const Value &value);
+    int64_t remove(const std::vector<Key> &keys);
+    void resetStats();
+    void setFilter(const BloomFilter &filter);
+    void setLimit(int64_t limit);
+    void setHashFunction(const HashFunction &hashFunction);
+    void setWideTags(bool enabled);
+    Statistics stats() const;
+    void swap(Hash &other);
+    std::pair<iterator, bool> try_emplace(const Key &key, const Value &value = Value());
+    template<typename Function>
+    bool upsert(const Key &key, const Value &value, Function function);
     Value value(const Key &key, const Value &defaultValue = Value()) const;
     std::vector<Value> values(const Key &key) const;
+    bool wideTags() const;
 
 private:
+    template<typename, typename, typename, typename, typename, typename>
+    friend class Hash;
+
     enum class MetaValues : char
     {
         Empty = static_cast<char>(0b10000000),
@@ -59,65 +117,148 @@ private:
         Mask = static_cast<char>(0b01111111)
     };
 
+    struct NoHashFunction
+    {
+    };
+
+    using HashFunctionType = typename std::conditional<IsStatefulHash<HashFunction, Key>::value, HashFunction, NoHashFunction>::type;
+
+    enum class Probe
+    {
+        Lookup,
+        Insert,
+        Rehash
+    };
+
+    class ReferenceFlag;
+    struct Extension;
+
+    void allocate();
+    template<typename Combiner>
+    bool aggregateAt(const Key &key, const Value &value, int64_t home, uint64_t hash, Combiner combine);
+    template<typename Combiner>
+    void aggregateBatch(const Key *keys, const Value *values, int64_t count, Combiner combine);
     int64_t dataIndex(int64_t index) const;
+    int64_t dataMemoryUsage(std::false_type) const;
+    int64_t dataMemoryUsage(std::true_type) const;
     char deleteMetaValue(int64_t index) const;
     int64_t capacity() const;
     void eraseAt(int64_t index);
-    std::vector<int64_t> findAll(const Key &key) const;
-    std::vector<int64_t> findAll(const Key &key, const Value &value) const;
-    template<typename Comparator>
-    std::vector<int64_t> findAll(int64_t index, char metaValue, Comparator compare) const;
-    int64_t findEmpty(int64_t index) const;
+    void eraseAt(int64_t index, uint64_t hash);
+    void evict();
+    Extension &extension();
+    int64_t findEmpty(int64_t index, char metaValue, Probe probe) const;
     int64_t findIndex(const Key &key) const;
     int64_t findIndex(const Key &key, const Value &value) const;
     template<typename Comparator>
-    int64_t findIndex(int64_t index, char metaValue, Comparator compare) const;
+    int64_t findIndex(int64_t index, char metaValue, char tag, Comparator compare) const;
+    template<typename Callback>
+    void findIndexes(const Key &key, int64_t index, char metaValue, char tag, Callback callback) const;
     int64_t findNext(int64_t index = -1) const;
     int64_t findPrevious(int64_t index) const;
-    int64_t freeIndex(int64_t index, int64_t newSize);
+    FrozenHash<Key, Value, HashFunction> freeze(std::vector<std::pair<Key, Value>> data, std::false_type) const;
+    FrozenHash<Key, Value, HashFunction> freeze(std::vector<std::pair<Key, Value>> data, std::true_type) const;
+    void fit();
+    template<typename Comparator>
+    std::pair<int64_t, bool> findSlot(int64_t index, char metaValue, char tag, Comparator compare) const;
     void grow();
     void grow(int64_t oldSize, int64_t newSize);
     BitMask<uint16_t> findEmptyPositions(int64_t index) const;
-    BitMask<uint16_t> findPositions(int64_t index, char metaValue) const;
+    BitMask<uint16_t> findPositions(int64_t index, char metaValue, char tag) const;
+    BitMask<uint16_t> findValidPositions(int64_t index) const;
+    int64_t groupDistance(int64_t index, int64_t home) const;
+    static int64_t groupIndex(int64_t index);
     static int64_t hashIndex(uint64_t hash, int64_t size);
+    uint64_t hashKey(const Key &key) const;
+    uint64_t hashKey(const Key &key, std::false_type) const;
+    uint64_t hashKey(const Key &key, std::true_type) const;
     static char hashMetaValue(uint64_t hash);
+    static char hashTag(uint64_t hash);
     int64_t insertData(int64_t index, const Key &key, const Value &value, char metaValue);
+    int64_t insertNew(int64_t index, const Key &key, const Value &value, uint64_t hash);
+    void insertReserved(const Key &key, const Value &value);
+    std::pair<int64_t, bool> insertUnique(const Key &key, const Value &value, bool assign);
+    bool isAdoptable(const Hash &other) const;
     bool isBewloMinCount() const;
     bool isEmpty(int64_t index) const;
     bool isFree(int64_t index) const;
+    bool isAtLimit() const;
     bool isGroupFull(int64_t index) const;
     bool isDeleted(int64_t index) const;
     bool isOverMaxCount() const;
+    bool isOverMaxDeletedCount() const;
+    bool isOverflowed(int64_t index) const;
+    bool isProbeTooLong(int64_t index, int64_t home, char metaValue) const;
     bool isValid(int64_t index) const;
+    template<typename Callback>
+    void joinBatch(const Key *keys, int64_t count, Callback callback) const;
     static auto keyComparator(const Key &key, const DataType &data);
     static auto keyValueComparator(const Key &key, const Value &val, const DataType &data);
+    void markIndexes(int64_t size);
+    uint16_t matchPositions(int64_t index, char metaValue, char tag) const;
     int64_t maxCount() const;
+    int64_t maxDeletedCount() const;
+    bool mayContain(uint64_t hash) const;
     int64_t minCount() const;
-    int64_t nextGroupIndex(int64_t index) const;
-    int64_t nextGroupIndex(int64_t index, int64_t size) const;
+    template<typename Function>
+    void modifyAt(int64_t index, Function function);
+    template<typename Function>
+    void modifyAt(int64_t index, Function function, std::false_type);
+    template<typename Function>
+    void modifyAt(int64_t index, Function function, std::true_type);
+    int64_t nextGroupIndex(int64_t index, int64_t groups, char metaValue) const;
     int64_t nextIndex(int64_t index) const;
     int64_t nextIndex(int64_t index, int64_t size) const;
-    int64_t reinsert(int64_t index, int64_t newSize);
-    int64_t reinsert(int64_t index, int64_t newIndex, const Key &key, int64_t newSize);
-    void rehash();
+    void prefetchBatch(const Key *keys, int64_t count, uint64_t *hashes, int64_t *indexes) const;
+    void prefetchData(int64_t index) const;
+    void prefetchData(int64_t index, std::false_type) const;
+    void prefetchData(int64_t index, std::true_type) const;
+    void prefetchMetaData(int64_t index) const;
+    void prefetchMetaData(int64_t index, std::false_type) const;
+    void prefetchMetaData(int64_t index, std::true_type) const;
+    bool rehash();
     void rehash(int64_t newSize);
     void rehash(int64_t oldSize, int64_t newSize);
-    void rehashIndex(int64_t index, int64_t newSize);
-    void rehashIndexes(int64_t size, int64_t newSize);
+    void rehashIndex(int64_t index);
+    void rehashIndexes(int64_t size);
+    void recordGroup(int64_t index) const;
+    void recordProbe(Probe probe, int64_t groups) const;
+    void recordRehash(int64_t oldSize, int64_t newSize);
+    void recordReseed();
+    void recordTag(bool match) const;
+    void reserve(int64_t count);
+    bool reseed();
+    bool reseed(std::false_type);
+    bool reseed(std::true_type);
+    void reference(int64_t index, bool referenced) const;
     void resize(int64_t size);
     void setMetaValue(int64_t index, MetaValues value);
     void setMetaValue(int64_t index, char value);
+    void setTag(int64_t index, uint64_t hash);
     void shrink();
     void squeeze(int64_t oldSize, int64_t newSize);
-    char takeMetaValue(int64_t index);
+    void swapReferences(int64_t index, int64_t other);
+    void updateOverflows(int64_t home, int64_t index, char metaValue, int64_t delta);
 
+    static constexpr uint64_t CLOCK_STRIDE = 0x9E3779B97F4A7C15ULL;
     static constexpr int64_t GROUP_SIZE = 16;
-    DataType mData = DataType(GROUP_SIZE, GROUP_SIZE * 2, static_cast<char>(MetaValues::Empty));
+    static constexpr int64_t BATCH_SIZE = 16;
+    static constexpr int64_t MAX_PROBE_GROUPS = 32;
+    static constexpr uint8_t MAX_OVERFLOW = UINT8_MAX;
+    static constexpr int64_t PREFETCH_CAPACITY = 1 << 14;
+#ifdef ADB_STATISTICS
+    mutable Statistics mStatistics;
+#endif
+    DataType mData = DataType(GROUP_SIZE, GROUP_SIZE, static_cast<char>(MetaValues::Empty));
+    HashFunctionType mHashFunction;
+    std::vector<uint8_t> mOverflows;
+    std::unique_ptr<Extension> mExtension;
+    int64_t mReseedCapacity = 0;
 };
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-class Hash<Key, Value, DataType, HashFunction>::iterator_base
+class Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base
 {
 public:
     using value_type = ValueType;
@@ -146,658 +287,2008 @@ private:
     HashType *mHash = nullptr;
 };
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+class Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base
+{
+public:
+    using value_type = ValueType;
+    using pointer = value_type *;
+    using reference = ReferenceType;
+    using difference_type = ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    key_iterator_base() = default;
+    explicit key_iterator_base(HashType *hash);
+    key_iterator_base(const Key &key, HashType *hash);
+
+    key_iterator_base &operator++();
+    key_iterator_base operator++(int);
+    bool operator==(const key_iterator_base &other) const;
+    bool operator!=(const key_iterator_base &other) const;
+    Key key() const;
+    value_type value() const;
+    reference operator*() const;
+
+private:
+    friend class Hash;
+
+    void findNext();
+    void loadGroup(int64_t index);
+
+    int64_t mIndex = -1;
+    int64_t mGroupIndex = -1;
+    uint16_t mPositions = 0;
+    char mMetaValue = 0;
+    char mTag = 0;
+    int64_t mGroups = 0;
+    Key mKey = Key();
+    HashType *mHash = nullptr;
+};
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+class Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::ReferenceFlag
+{
+public:
+    ReferenceFlag() = default;
+    ReferenceFlag(const ReferenceFlag &other);
+
+    ReferenceFlag &operator=(const ReferenceFlag &other);
+    bool isSet() const;
+    void set(bool referenced);
+
+private:
+    std::atomic<bool> mReferenced{false};
+};
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+struct Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::Extension
+{
+    BloomFilter filter;
+    int64_t limit = 0;
+    int64_t clock = 0;
+    std::vector<ReferenceFlag> references;
+    bool wideTags = false;
+    std::vector<char, AlignedAllocator<char, 64>> tags;
+};
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename... T>
-Hash<Key, Value, DataType, HashFunction>::Hash(T... args) :
-    mData(GROUP_SIZE, GROUP_SIZE * 2, static_cast<char>(MetaValues::Empty), args...)
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::Hash(T... args) :
+    mData(0, 0, static_cast<char>(MetaValues::Empty), args...)
+{
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::Hash(const Hash &other) :
+#ifdef ADB_STATISTICS
+    mStatistics(other.mStatistics),
+#endif
+    mData(other.mData),
+    mHashFunction(other.mHashFunction),
+    mOverflows(other.mOverflows),
+    mExtension(other.mExtension ? std::make_unique<Extension>(*other.mExtension) : nullptr),
+    mReseedCapacity(other.mReseedCapacity)
+{
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::Hash(Hash &&other) :
+#ifdef ADB_STATISTICS
+    mStatistics(other.mStatistics),
+#endif
+    mData(std::move(other.mData)),
+    mHashFunction(std::move(other.mHashFunction)),
+    mOverflows(std::move(other.mOverflows)),
+    mExtension(std::move(other.mExtension)),
+    mReseedCapacity(other.mReseedCapacity)
+{
+    other.clear();
+    other.resetStats();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename KeyIterator, typename ValueIterator, typename Combiner>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::aggregate(KeyIterator firstKey, KeyIterator lastKey, ValueIterator firstValue, Combiner combine)
 {
+    Key keys[BATCH_SIZE];
+    Value values[BATCH_SIZE];
+
+    while(firstKey != lastKey)
+    {
+        int64_t count = 0;
+
+        for(; count < BATCH_SIZE && firstKey != lastKey; count++, ++firstKey, ++firstValue)
+        {
+            keys[count] = *firstKey;
+            values[count] = *firstValue;
+        }
+
+        aggregateBatch(keys, values, count, combine);
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::begin() -> iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::begin() -> iterator
 {
     return iterator(findNext(), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::cbegin() const -> const_iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::cbegin() const -> const_iterator
 {
     return const_iterator(findNext(), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::cend() const -> const_iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::cend() const -> const_iterator
 {
     return const_iterator(mData.dataSize(), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::clear()
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::clear()
 {
-    mData.resize(GROUP_SIZE, GROUP_SIZE * 2, static_cast<char>(MetaValues::Empty));
-    mData.setMetaData(0, std::vector<char>(GROUP_SIZE * 2, static_cast<char>(MetaValues::Empty)));
+    mData.resize(0, 0, static_cast<char>(MetaValues::Empty));
     mData.setCount(0);
+    mData.setDeletedCount(0);
+    mOverflows.clear();
+
+    if(mExtension)
+    {
+        mExtension->filter.reset(0);
+        mExtension->clock = 0;
+        mExtension->references.clear();
+        mExtension->tags.clear();
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::contains(const Key &key) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::contains(const Key &key) const
 {
     return find(key) != cend();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::contains(const Key &key, const Value &value) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::contains(const Key &key, const Value &value) const
 {
     return find(key, value) != cend();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::count() const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::count() const
 {
     return mData.count();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::count(const Key &key) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::count(const Key &key) const
 {
-    return findAll(key).size();
+    const std::pair<const_key_iterator, const_key_iterator> range = equal_range(key);
+    return std::distance(range.first, range.second);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::count(const Key &key, const Value &value) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::count(const Key &key, const Value &value) const
 {
-    return findAll(key, value).size();
+    int64_t counted = 0;
+
+    for(std::pair<const_key_iterator, const_key_iterator> range = equal_range(key); range.first != range.second; ++range.first)
+        if(mData.value(range.first.mIndex) == value)
+            counted++;
+
+    return counted;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::end() -> iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::end() -> iterator
 {
     return iterator(capacity(), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::erase(const_iterator it) -> const_iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::equal_range(const Key &key) const -> std::pair<const_key_iterator, const_key_iterator>
+{
+    return {const_key_iterator(key, this), const_key_iterator(this)};
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::equal_range(const Key &key) -> std::pair<key_iterator, key_iterator>
+{
+    return {key_iterator(key, this), key_iterator(this)};
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::erase(const_iterator it) -> const_iterator
 {
     eraseAt(it.mIndex);
     return ++it;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::erase(iterator it) -> iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::erase(iterator it) -> iterator
 {
     eraseAt(it.mIndex);
     return ++it;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::find(const Key &key) const -> const_iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Predicate>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::erase_if(Predicate predicate)
+{
+    int64_t removed = 0;
+
+    for(int64_t group = 0; group < capacity(); group += GROUP_SIZE)
+    {
+        for(int i : findValidPositions(group))
+        {
+            if(predicate(mData.key(group + i), mData.value(group + i)))
+            {
+                eraseAt(group + i);
+                removed++;
+            }
+        }
+    }
+
+    fit();
+
+    return removed;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+const BloomFilter &Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::filter() const
+{
+    static const BloomFilter disabled;
+    return mExtension ? mExtension->filter : disabled;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::find(const Key &key) const -> const_iterator
 {
     return const_iterator(findIndex(key), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::find(const Key &key, const Value &value) const -> const_iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::find(const Key &key, const Value &value) const -> const_iterator
 {
     return const_iterator(findIndex(key, value), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::find(const Key &key) -> iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::find(const Key &key) -> iterator
 {
     return iterator(findIndex(key), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::find(const Key &key, const Value &value) -> iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::find(const Key &key, const Value &value) -> iterator
 {
     return iterator(findIndex(key, value), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::insert(const Key &key, const Value &value) -> iterator
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Iterator, typename Callback>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::find(Iterator first, Iterator last, Callback callback, int64_t depth) const
 {
-    mData.setCount(mData.count() + 1);
-    rehash();
-    const uint64_t hash = HashFunction(key);
-    return iterator(insertData(findEmpty(hashIndex(hash, capacity())), key, value, hashMetaValue(hash)), this);
-}
+    std::vector<Key> keys(static_cast<size_t>(std::max<int64_t>(depth, 1)));
+    std::vector<uint64_t> hashes(keys.size());
+    std::vector<int64_t> indexes(keys.size());
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isEmpty() const
-{
-    return count() == 0;
+    while(first != last)
+    {
+        int64_t count = 0;
+
+        for(; count < static_cast<int64_t>(keys.size()) && first != last; count++, ++first)
+            keys[count] = *first;
+
+        prefetchBatch(keys.data(), count, hashes.data(), indexes.data());
+
+        for(int64_t position = 0; position < count; position++)
+        {
+            const int64_t index = mayContain(hashes[position]) ? findIndex(indexes[position], hashMetaValue(hashes[position]), hashTag(hashes[position]), keyComparator(keys[position], mData)) : capacity();
+            callback(keys[position], const_iterator(index, this));
+        }
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-Reference<Value, DataType> Hash<Key, Value, DataType, HashFunction>::operator[](const Key &key)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+FrozenHash<Key, Value, HashFunction> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::freeze() const
 {
-    const int64_t index = findIndex(key);
-    return Reference<Value, DataType>(mData, index < capacity() ? index : insert(key, Value()).mIndex);
+    std::vector<std::pair<Key, Value>> data;
+    data.reserve(static_cast<size_t>(count()));
+
+    for(auto it = cbegin(); it != cend(); ++it)
+        data.emplace_back(it.key(), it.value());
+
+    return freeze(std::move(data), IsStatefulHash<HashFunction, Key>());
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-Value Hash<Key, Value, DataType, HashFunction>::operator[](const Key &key) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+const HashFunction &Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashFunction() const
 {
-    const int64_t pos = findIndex(key);
-    return pos != capacity() ? mData.value(pos) : Value();
+    return mHashFunction;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::replace(const Key &key, const Value &newValue)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::insert(const Key &key, const Value &value) -> iterator
 {
-    int64_t replaced = 0;
+    if(std::is_same<KeyPolicy, UniqueKey>::value)
+        return insert_or_assign(key, value).first;
+
+    allocate();
+
+    if(isAtLimit())
+        evict();
+
+    mData.setCount(mData.count() + 1);
+    rehash();
+    uint64_t hash = hashKey(key);
+    const int64_t home = hashIndex(hash, capacity());
+    int64_t index = findEmpty(home, hashMetaValue(hash), Probe::Insert);
 
-    for(int64_t pos : findAll(key))
+    if(isProbeTooLong(index, home, hashMetaValue(hash)) && reseed())
     {
-        mData.setValue(pos, newValue);
-        replaced++;
+        hash = hashKey(key);
+        index = findEmpty(hashIndex(hash, capacity()), hashMetaValue(hash), Probe::Rehash);
     }
 
-    return replaced;
+    return iterator(insertNew(index, key, value, hash), this);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::replace(const Key &key, const Value &oldValue, const Value &newValue)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::insert_or_assign(const Key &key, const Value &value) -> std::pair<iterator, bool>
 {
-    int64_t replaced = 0;
+    const std::pair<int64_t, bool> result = insertUnique(key, value, true);
+    return {iterator(result.first, this), result.second};
+}
 
-    for(int64_t pos : findAll(key, oldValue))
-    {
-        mData.setValue(pos, newValue);
-        replaced++;
-    }
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isEmpty() const
+{
+    return count() == 0;
+}
 
-    return replaced;
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::limit() const
+{
+    return mExtension ? mExtension->limit : 0;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::remove(const Key &key)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename OtherValue, typename OtherData, typename OtherHashFunction, typename OtherKeyPolicy, typename OtherProbePolicy, typename Callback>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::join(const Hash<Key, OtherValue, OtherData, OtherHashFunction, OtherKeyPolicy, OtherProbePolicy> &other, Callback callback, int64_t part, int64_t parts) const
 {
-    int64_t removed = 0;
+    Key keys[BATCH_SIZE];
+    OtherValue values[BATCH_SIZE];
+    const int64_t last = other.capacity() * (part + 1) / parts;
+    int64_t index = other.findNext(other.capacity() * part / parts - 1);
 
-    for(int64_t pos : findAll(key))
+    while(index < last)
     {
-        eraseAt(pos);
-        removed++;
-    }
+        int64_t count = 0;
 
-    rehash();
+        for(; count < BATCH_SIZE && index < last; count++, index = other.findNext(index))
+        {
+            keys[count] = other.mData.key(index);
+            values[count] = other.mData.value(index);
+        }
 
-    return removed;
+        joinBatch(keys, count, [&](int64_t position, int64_t match) { callback(keys[position], values[position], mData.value(match)); });
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::remove(const Key &key, const Value &value)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Iterator, typename Callback>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::join(Iterator first, Iterator last, Callback callback) const
 {
-    int64_t removed = 0;
+    Key keys[BATCH_SIZE];
 
-    for(int64_t pos : findAll(key, value))
+    while(first != last)
     {
-        eraseAt(pos);
-        removed++;
-    }
+        int64_t count = 0;
 
-    rehash();
+        for(; count < BATCH_SIZE && first != last; count++, ++first)
+            keys[count] = *first;
 
-    return removed;
+        joinBatch(keys, count, [&](int64_t position, int64_t match) { callback(keys[position], mData.value(match)); });
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-Value Hash<Key, Value, DataType, HashFunction>::value(const Key &key, const Value &defaultValue) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::memoryUsage() const
 {
-    const int64_t pos = findIndex(key);
-    return pos != capacity() ? mData.value(pos) : defaultValue;
+    int64_t usage = static_cast<int64_t>(sizeof(*this)) + dataMemoryUsage(HasMemoryUsage<DataType>()) + static_cast<int64_t>(mOverflows.size());
+
+    if(mExtension)
+        usage += static_cast<int64_t>(sizeof(Extension) + mExtension->references.size() * sizeof(ReferenceFlag) + mExtension->tags.size()) + mExtension->filter.memoryUsage();
+
+    return usage;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-std::vector<Value> Hash<Key, Value, DataType, HashFunction>::values(const Key &key) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::merge(const Hash &other)
 {
-    std::vector<Value> vals;
+    if(&other == this)
+    {
+        merge(Hash(other));
+        return;
+    }
+
+    if(isEmpty() && isAdoptable(other))
+    {
+        mData = other.mData;
+        mHashFunction = other.mHashFunction;
+        mOverflows = other.mOverflows;
+        mExtension = other.mExtension ? std::make_unique<Extension>(*other.mExtension) : nullptr;
+        mReseedCapacity = other.mReseedCapacity;
+        return;
+    }
 
-    for(int64_t pos : findAll(key))
-        vals.emplace_back(mData.value(pos));
+    reserve(count() + other.count());
 
-    return vals;
+    for(int64_t index = other.findNext(); index < other.capacity(); index = other.findNext(index))
+        insertReserved(other.mData.key(index), other.mData.value(index));
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::dataIndex(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::merge(Hash &&other)
 {
-    return index % capacity();
+    if(isEmpty() && isAdoptable(other))
+        swap(other);
+    else
+        merge(static_cast<const Hash &>(other));
+
+    other.clear();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-char Hash<Key, Value, DataType, HashFunction>::deleteMetaValue(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Function>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::modify(const Key &key, Function function)
 {
-    return match(static_cast<char>(MetaValues::Empty), mData.metaData(index, GROUP_SIZE)) ? static_cast<char>(MetaValues::Empty) : static_cast<char>(MetaValues::Deleted);
+    int64_t modified = 0;
+
+    for(std::pair<key_iterator, key_iterator> range = equal_range(key); range.first != range.second; ++range.first)
+    {
+        modifyAt(range.first.mIndex, function);
+        modified++;
+    }
+
+    return modified;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::capacity() const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::operator=(const Hash &other) -> Hash &
 {
-    return mData.dataSize();
+    Hash hash(other);
+    swap(hash);
+    return *this;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::eraseAt(int64_t index)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::operator=(Hash &&other) -> Hash &
 {
-    setMetaValue(index, deleteMetaValue(index));
-    mData.setCount(mData.count() - 1);
+    Hash hash(std::move(other));
+    swap(hash);
+    return *this;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-std::vector<int64_t> Hash<Key, Value, DataType, HashFunction>::findAll(const Key &key) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Reference<Value, DataType> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::operator[](const Key &key)
 {
-    const uint64_t hash = HashFunction(key);
-    return findAll(hashIndex(hash, capacity()), hashMetaValue(hash), keyComparator(key, mData));
+    return Reference<Value, DataType>(mData, insertUnique(key, Value(), false).first);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-std::vector<int64_t> Hash<Key, Value, DataType, HashFunction>::findAll(const Key &key, const Value &value) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Value Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::operator[](const Key &key) const
 {
-    const uint64_t hash = HashFunction(key);
-    return findAll(hashIndex(hash, capacity()), hashMetaValue(hash), keyValueComparator(key, value, mData));
+    const int64_t pos = findIndex(key);
+    return pos != capacity() ? mData.value(pos) : Value();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-template<typename Comparator>
-std::vector<int64_t> Hash<Key, Value, DataType, HashFunction>::findAll(int64_t index, char metaValue, Comparator compare) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::replace(const Key &key, const Value &newValue)
 {
-    std::vector<int64_t> indexes;
+    int64_t replaced = 0;
 
-    while(true)
+    for(std::pair<key_iterator, key_iterator> range = equal_range(key); range.first != range.second; ++range.first)
     {
-        for(int i : findPositions(index, metaValue))
-            if(compare(dataIndex(index + i)))
-                indexes.emplace_back(dataIndex(index + i));
-
-        if(!isGroupFull(index))
-            break;
-
-        index = nextGroupIndex(index);
+        mData.setValue(range.first.mIndex, newValue);
+        replaced++;
     }
 
-    return indexes;
+    return replaced;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::findEmpty(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::replace(const Key &key, const Value &oldValue, const Value &newValue)
 {
-    while(true)
-    {
-        BitMask<uint16_t> positions = findEmptyPositions(index);
-
-        if(!positions.none())
-            return dataIndex(index + (*positions.begin()));
+    int64_t replaced = 0;
 
-        index = nextGroupIndex(index);
+    for(std::pair<key_iterator, key_iterator> range = equal_range(key); range.first != range.second; ++range.first)
+    {
+        if(mData.value(range.first.mIndex) == oldValue)
+        {
+            mData.setValue(range.first.mIndex, newValue);
+            replaced++;
+        }
     }
-}
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::findIndex(const Key &key) const
-{
-    const uint64_t hash = HashFunction(key);
-    return findIndex(hashIndex(hash, capacity()), hashMetaValue(hash), keyComparator(key, mData));
+    return replaced;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::findIndex(const Key &key, const Value &value) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::remove(const Key &key)
 {
-    const uint64_t hash = HashFunction(key);
-    return findIndex(hashIndex(hash, capacity()), hashMetaValue(hash), keyValueComparator(key, value, mData));
-}
+    const uint64_t hash = hashKey(key);
+    int64_t removed = 0;
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-template<typename Comparator>
-int64_t Hash<Key, Value, DataType, HashFunction>::findIndex(int64_t index, char metaValue, Comparator compare) const
-{
-    while(true)
+    if(mayContain(hash))
     {
-        for(int i : findPositions(index, metaValue))
-            if(compare(dataIndex(index + i)))
-                return dataIndex(index + i);
+        findIndexes(key, hashIndex(hash, capacity()), hashMetaValue(hash), hashTag(hash), [&](int64_t index) {
+            eraseAt(index, hash);
+            removed++;
+        });
+    }
 
-        if(!isGroupFull(index))
-            return capacity();
+    rehash();
 
-        index = nextGroupIndex(index);
-    }
+    return removed;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::findNext(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::remove(const Key &key, const Value &value)
 {
-    for(++index; index < capacity(); ++index)
-        if(isValid(index))
-            break;
+    const uint64_t hash = hashKey(key);
+    int64_t removed = 0;
 
-    return index;
-}
+    if(mayContain(hash))
+    {
+        findIndexes(key, hashIndex(hash, capacity()), hashMetaValue(hash), hashTag(hash), [&](int64_t index) {
+            if(mData.value(index) == value)
+            {
+                eraseAt(index, hash);
+                removed++;
+            }
+        });
+    }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::findPrevious(int64_t index) const
-{
-    for(--index; 0 <= index; --index)
-        if(isValid(index))
-            break;
+    rehash();
 
-    return index;
+    return removed;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::freeIndex(int64_t index, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::remove(const std::vector<Key> &keys)
 {
-    while(!isFree(index) && reinsert(index, newSize) == index)
-        index = nextIndex(index, newSize);
+    const int64_t count = mData.count();
+    uint64_t hashes[BATCH_SIZE];
+    int64_t indexes[BATCH_SIZE];
 
-    return index;
-}
+    for(int64_t first = 0; first < static_cast<int64_t>(keys.size()); first += BATCH_SIZE)
+    {
+        const int64_t size = std::min(static_cast<int64_t>(BATCH_SIZE), static_cast<int64_t>(keys.size()) - first);
+        prefetchBatch(&keys[first], size, hashes, indexes);
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::grow()
-{
-    rehash(capacity() * 2);
+        for(int64_t position = 0; position < size; position++)
+            if(mayContain(hashes[position]))
+                findIndexes(keys[first + position], indexes[position], hashMetaValue(hashes[position]), hashTag(hashes[position]), [&](int64_t index) { eraseAt(index, hashes[position]); });
+    }
+
+    fit();
+
+    return count - mData.count();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::grow(int64_t oldSize, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::resetStats()
 {
-    if(newSize > oldSize)
-        resize(newSize);
+#ifdef ADB_STATISTICS
+    mStatistics = Statistics();
+#endif
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-BitMask<uint16_t> Hash<Key, Value, DataType, HashFunction>::findEmptyPositions(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setFilter(const BloomFilter &filter)
 {
-    const char *metaData = mData.metaData(index, GROUP_SIZE);
-    return BitMask<uint16_t>(match(static_cast<char>(MetaValues::Empty), metaData) | match(static_cast<char>(MetaValues::Deleted), metaData));
+    extension().filter = filter;
+    rehash(capacity());
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-BitMask<uint16_t> Hash<Key, Value, DataType, HashFunction>::findPositions(int64_t index, char metaValue) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setLimit(int64_t limit)
 {
-    return BitMask<uint16_t>(match(metaValue, mData.metaData(index, GROUP_SIZE)));
+    Extension &ext = extension();
+    ext.limit = std::max<int64_t>(limit, 0);
+    ext.clock = 0;
+    ext.references.assign(ext.limit != 0 ? capacity() : 0, ReferenceFlag());
+
+    while(count() > ext.limit && ext.limit != 0)
+        evict();
+
+    fit();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::hashIndex(uint64_t hash, int64_t size)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setHashFunction(const HashFunction &hashFunction)
 {
-    return static_cast<int64_t>(hash % static_cast<uint64_t>(size));
+    mHashFunction = hashFunction;
+    rehash(capacity());
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-char Hash<Key, Value, DataType, HashFunction>::hashMetaValue(uint64_t hash)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setWideTags(bool enabled)
 {
-    return hash & static_cast<char>(MetaValues::Mask);
+    Extension &ext = extension();
+    ext.wideTags = enabled;
+    ext.tags.assign(static_cast<size_t>(enabled ? capacity() : 0), 0);
+
+    if(enabled)
+        rehash(capacity());
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::insertData(int64_t index, const Key &key, const Value &value, char metaValue)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Statistics Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::stats() const
 {
-    setMetaValue(index, metaValue);
-    mData.setData(index, key, value);
-    return index;
+#ifdef ADB_STATISTICS
+    Statistics statistics = mStatistics;
+#else
+    Statistics statistics;
+#endif
+    statistics.count = count();
+    statistics.capacity = capacity();
+    statistics.deletedCount = mData.deletedCount();
+    statistics.loadFactor = capacity() != 0 ? static_cast<double>(count()) / capacity() : 0;
+    return statistics;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isBewloMinCount() const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::swap(Hash &other)
 {
-    return mData.count() < minCount();
+    using std::swap;
+#ifdef ADB_STATISTICS
+    swap(mStatistics, other.mStatistics);
+#endif
+    swap(mData, other.mData);
+    swap(mHashFunction, other.mHashFunction);
+    swap(mOverflows, other.mOverflows);
+    swap(mExtension, other.mExtension);
+    swap(mReseedCapacity, other.mReseedCapacity);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isEmpty(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::try_emplace(const Key &key, const Value &value) -> std::pair<iterator, bool>
 {
-    return *mData.metaData(index, 1) == static_cast<char>(MetaValues::Empty);
+    const std::pair<int64_t, bool> result = insertUnique(key, value, false);
+    return {iterator(result.first, this), result.second};
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isFree(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Function>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::upsert(const Key &key, const Value &value, Function function)
 {
-    return isEmpty(index) || isDeleted(index);
+    const std::pair<int64_t, bool> result = insertUnique(key, value, false);
+
+    if(!result.second)
+        modifyAt(result.first, function);
+
+    return result.second;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isGroupFull(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Value Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::value(const Key &key, const Value &defaultValue) const
 {
-    return match(static_cast<char>(MetaValues::Empty), mData.metaData(index, GROUP_SIZE)) == 0;
+    const int64_t pos = findIndex(key);
+    return pos != capacity() ? mData.value(pos) : defaultValue;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isDeleted(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+std::vector<Value> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::values(const Key &key) const
 {
-    return *mData.metaData(index, 1) == static_cast<char>(MetaValues::Deleted);
+    std::vector<Value> vals;
+
+    for(std::pair<const_key_iterator, const_key_iterator> range = equal_range(key); range.first != range.second; ++range.first)
+        vals.emplace_back(mData.value(range.first.mIndex));
+
+    return vals;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isOverMaxCount() const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::wideTags() const
 {
-    return mData.count() >= maxCount();
+    return mExtension && mExtension->wideTags;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-bool Hash<Key, Value, DataType, HashFunction>::isValid(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::allocate()
 {
-    return (*mData.metaData(index, 1) >> 7) == static_cast<char>(MetaValues::Valid);
+    if(capacity() == 0)
+        rehash(GROUP_SIZE);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::keyComparator(const Key &key, const DataType &data)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Combiner>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::aggregateAt(const Key &key, const Value &value, int64_t home, uint64_t hash, Combiner combine)
 {
-    return [&key, &data](int64_t index) { return data.key(index) == key; };
+    const std::pair<int64_t, bool> slot = mayContain(hash) ? findSlot(home, hashMetaValue(hash), hashTag(hash), keyComparator(key, mData)) : std::pair<int64_t, bool>(findEmpty(home, hashMetaValue(hash), Probe::Insert), false);
+
+    if(slot.second)
+    {
+        mData.setValue(slot.first, combine(mData.value(slot.first), value));
+        return false;
+    }
+
+    int64_t index = slot.first;
+
+    if(isAtLimit())
+    {
+        evict();
+        index = findEmpty(home, hashMetaValue(hash), Probe::Insert);
+    }
+
+    mData.setCount(mData.count() + 1);
+
+    if(rehash() || (isProbeTooLong(index, home, hashMetaValue(hash)) && reseed()))
+    {
+        const uint64_t newHash = hashKey(key);
+        insertNew(findEmpty(hashIndex(newHash, capacity()), hashMetaValue(newHash), Probe::Rehash), key, value, newHash);
+        return true;
+    }
+
+    insertNew(index, key, value, hash);
+    return false;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-auto Hash<Key, Value, DataType, HashFunction>::keyValueComparator(const Key &key, const Value &val, const DataType &data)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Combiner>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::aggregateBatch(const Key *keys, const Value *values, int64_t count, Combiner combine)
 {
-    return [&key, &val, &data](int64_t index) { return data.key(index) == key && data.value(index) == val; };
+    uint64_t hashes[BATCH_SIZE];
+    int64_t indexes[BATCH_SIZE];
+    bool rehashed = false;
+
+    allocate();
+    prefetchBatch(keys, count, hashes, indexes);
+
+    for(int64_t position = 0; position < count; position++)
+    {
+        if(rehashed)
+        {
+            hashes[position] = hashKey(keys[position]);
+            indexes[position] = hashIndex(hashes[position], capacity());
+        }
+
+        rehashed = aggregateAt(keys[position], values[position], indexes[position], hashes[position], combine) || rehashed;
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::maxCount() const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::dataIndex(int64_t index) const
 {
-    return capacity() * 15 / 16;
+    return index % capacity();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::minCount() const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::dataMemoryUsage(std::false_type) const
 {
-    return capacity() * 7 / 16;
+    return capacity() * static_cast<int64_t>(sizeof(std::pair<Key, Value>)) + mData.metaSize();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::nextGroupIndex(int64_t index) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::dataMemoryUsage(std::true_type) const
 {
-    return nextGroupIndex(index, capacity());
+    return mData.memoryUsage();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::nextGroupIndex(int64_t index, int64_t size) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+char Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::deleteMetaValue(int64_t index) const
 {
-    return (index + GROUP_SIZE) % size;
+    return isGroupFull(groupIndex(index)) && isOverflowed(index) ? static_cast<char>(MetaValues::Deleted) : static_cast<char>(MetaValues::Empty);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::nextIndex(int64_t index, int64_t size) const
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::capacity() const
 {
-    return (index + 1) % size;
+    return mData.dataSize();
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::reinsert(int64_t index, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::eraseAt(int64_t index)
 {
-    Key key = mData.key(index);
-    int64_t newPos = hashIndex(HashFunction(key), newSize);
-    return newPos == index ? index : reinsert(index, newPos, key, newSize);
+    eraseAt(index, hashKey(mData.key(index)));
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-int64_t Hash<Key, Value, DataType, HashFunction>::reinsert(int64_t index, int64_t newIndex, const Key &key, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::eraseAt(int64_t index, uint64_t hash)
 {
-    char metaValue = takeMetaValue(index);
-    Value value = mData.value(index);
-    return insertData(freeIndex(newIndex, newSize), key, value, metaValue);
+    updateOverflows(hashIndex(hash, capacity()), index, hashMetaValue(hash), -1);
+    const char metaValue = deleteMetaValue(index);
+
+    if(metaValue == static_cast<char>(MetaValues::Deleted))
+        mData.setDeletedCount(mData.deletedCount() + 1);
+
+    setMetaValue(index, metaValue);
+    mData.setCount(mData.count() - 1);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::rehash()
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::evict()
 {
-    if(isOverMaxCount())
-        grow();
-    else if(isBewloMinCount())
-        shrink();
+    const uint64_t groups = static_cast<uint64_t>(capacity() / GROUP_SIZE);
+
+    Extension &ext = *mExtension;
+
+    for(ext.clock %= capacity();; ext.clock = nextIndex(ext.clock, capacity()))
+    {
+        const int64_t index = static_cast<int64_t>(static_cast<uint64_t>(ext.clock / GROUP_SIZE) * CLOCK_STRIDE % groups) * GROUP_SIZE + ext.clock % GROUP_SIZE;
+
+        if(!isValid(index))
+            continue;
+
+        if(!ext.references[index].isSet())
+        {
+            eraseAt(index);
+            return;
+        }
+
+        ext.references[index].set(false);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::extension() -> Extension &
+{
+    if(!mExtension)
+        mExtension = std::make_unique<Extension>();
+
+    return *mExtension;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findEmpty(int64_t index, char metaValue, Probe probe) const
+{
+    for(int64_t groups = 1;; groups++)
+    {
+        BitMask<uint16_t> positions = findEmptyPositions(index);
+
+        if(!positions.none())
+        {
+            recordProbe(probe, groups);
+            return dataIndex(index + (*positions.begin()));
+        }
+
+        index = nextGroupIndex(index, groups, metaValue);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findIndex(const Key &key) const
+{
+    const uint64_t hash = hashKey(key);
+    return mayContain(hash) ? findIndex(hashIndex(hash, capacity()), hashMetaValue(hash), hashTag(hash), keyComparator(key, mData)) : capacity();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findIndex(const Key &key, const Value &value) const
+{
+    const uint64_t hash = hashKey(key);
+    return mayContain(hash) ? findIndex(hashIndex(hash, capacity()), hashMetaValue(hash), hashTag(hash), keyValueComparator(key, value, mData)) : capacity();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Comparator>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findIndex(int64_t index, char metaValue, char tag, Comparator compare) const
+{
+    for(int64_t groups = 1;; groups++)
+    {
+        for(int i : findPositions(index, metaValue, tag))
+        {
+            const bool match = compare(dataIndex(index + i));
+            recordTag(match);
+
+            if(match)
+            {
+                reference(dataIndex(index + i), true);
+                recordGroup(index);
+                recordProbe(Probe::Lookup, groups);
+                return dataIndex(index + i);
+            }
+        }
+
+        recordGroup(index);
+
+        if(!isGroupFull(index) || !isOverflowed(index))
+        {
+            recordProbe(Probe::Lookup, groups);
+            return capacity();
+        }
+
+        index = nextGroupIndex(index, groups, metaValue);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Callback>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findIndexes(const Key &key, int64_t index, char metaValue, char tag, Callback callback) const
+{
+    for(int64_t groups = 1;; groups++)
+    {
+        for(int i : findPositions(index, metaValue, tag))
+        {
+            const bool match = mData.key(dataIndex(index + i)) == key;
+            recordTag(match);
+
+            if(match)
+            {
+                reference(dataIndex(index + i), true);
+                callback(dataIndex(index + i));
+
+                if(std::is_same<KeyPolicy, UniqueKey>::value)
+                {
+                    recordGroup(index);
+                    recordProbe(Probe::Lookup, groups);
+                    return;
+                }
+            }
+        }
+
+        recordGroup(index);
+
+        if(!isGroupFull(index) || !isOverflowed(index))
+        {
+            recordProbe(Probe::Lookup, groups);
+            return;
+        }
+
+        index = nextGroupIndex(index, groups, metaValue);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findNext(int64_t index) const
+{
+    for(++index; index < capacity(); ++index)
+        if(isValid(index))
+            break;
+
+    return index;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findPrevious(int64_t index) const
+{
+    for(--index; 0 <= index; --index)
+        if(isValid(index))
+            break;
+
+    return index;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Comparator>
+std::pair<int64_t, bool> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findSlot(int64_t index, char metaValue, char tag, Comparator compare) const
+{
+    const int64_t home = index;
+    int64_t free = -1;
+
+    for(int64_t groups = 1;; groups++)
+    {
+        for(int i : findPositions(index, metaValue, tag))
+        {
+            const bool match = compare(dataIndex(index + i));
+            recordTag(match);
+
+            if(match)
+            {
+                reference(dataIndex(index + i), true);
+                recordGroup(index);
+                recordProbe(Probe::Insert, groups);
+                return {dataIndex(index + i), true};
+            }
+        }
+
+        if(free == -1)
+        {
+            BitMask<uint16_t> positions = findEmptyPositions(index);
+
+            if(!positions.none())
+                free = dataIndex(index + (*positions.begin()));
+        }
+
+        recordGroup(index);
+
+        if(!isGroupFull(index) || !isOverflowed(index))
+        {
+            if(free == -1)
+                return {findEmpty(home, metaValue, Probe::Insert), false};
+
+            recordProbe(Probe::Insert, groups);
+            return {free, false};
+        }
+
+        index = nextGroupIndex(index, groups, metaValue);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+FrozenHash<Key, Value, HashFunction> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::freeze(std::vector<std::pair<Key, Value>> data, std::false_type) const
+{
+    return FrozenHash<Key, Value, HashFunction>(std::move(data));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+FrozenHash<Key, Value, HashFunction> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::freeze(std::vector<std::pair<Key, Value>> data, std::true_type) const
+{
+    return FrozenHash<Key, Value, HashFunction>(std::move(data), mHashFunction);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::fit()
+{
+    int64_t size = capacity();
+
+    while(size > GROUP_SIZE && mData.count() < size * 7 / 16)
+        size /= 2;
+
+    if(size < capacity() || isOverMaxDeletedCount())
+    {
+        recordRehash(capacity(), size);
+        rehash(size);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::grow()
+{
+    rehash(capacity() * 2);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::grow(int64_t oldSize, int64_t newSize)
+{
+    if(newSize > oldSize)
+        resize(newSize);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+BitMask<uint16_t> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findEmptyPositions(int64_t index) const
+{
+    const char *metaData = mData.metaData(index, GROUP_SIZE);
+    return BitMask<uint16_t>(matchAligned(static_cast<char>(MetaValues::Empty), metaData) | matchAligned(static_cast<char>(MetaValues::Deleted), metaData));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+BitMask<uint16_t> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findPositions(int64_t index, char metaValue, char tag) const
+{
+    return BitMask<uint16_t>(matchPositions(index, metaValue, tag));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+BitMask<uint16_t> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::findValidPositions(int64_t index) const
+{
+    return BitMask<uint16_t>(static_cast<uint16_t>(~matchNegativeAligned(mData.metaData(index, GROUP_SIZE))));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::groupDistance(int64_t index, int64_t home) const
+{
+    return dataIndex(groupIndex(index) + capacity() - home) / GROUP_SIZE;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::groupIndex(int64_t index)
+{
+    return index - index % GROUP_SIZE;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashIndex(uint64_t hash, int64_t size)
+{
+    return groupIndex(static_cast<int64_t>(hash % static_cast<uint64_t>(size)));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+char Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashMetaValue(uint64_t hash)
+{
+    return (hash ^ (hash >> 57)) & static_cast<char>(MetaValues::Mask);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+char Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashTag(uint64_t hash)
+{
+    return static_cast<char>((hash ^ hash >> 32) >> 16);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+uint64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashKey(const Key &key) const
+{
+    return hashKey(key, IsStatefulHash<HashFunction, Key>());
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+uint64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashKey(const Key &key, std::false_type) const
+{
+    return HashFunction(key);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+uint64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::hashKey(const Key &key, std::true_type) const
+{
+    return mHashFunction(key);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::insertData(int64_t index, const Key &key, const Value &value, char metaValue)
+{
+    if(isDeleted(index))
+        mData.setDeletedCount(mData.deletedCount() - 1);
+
+    setMetaValue(index, metaValue);
+    mData.setData(index, key, value);
+    return index;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::insertNew(int64_t index, const Key &key, const Value &value, uint64_t hash)
+{
+    if(mExtension)
+        mExtension->filter.insert(hash);
+    reference(index, false);
+    updateOverflows(hashIndex(hash, capacity()), index, hashMetaValue(hash), 1);
+    setTag(index, hash);
+    return insertData(index, key, value, hashMetaValue(hash));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::insertReserved(const Key &key, const Value &value)
+{
+    uint64_t hash = hashKey(key);
+    const int64_t home = hashIndex(hash, capacity());
+    const std::pair<int64_t, bool> slot = std::is_same<KeyPolicy, UniqueKey>::value && mayContain(hash) ? findSlot(home, hashMetaValue(hash), hashTag(hash), keyComparator(key, mData)) : std::pair<int64_t, bool>(findEmpty(home, hashMetaValue(hash), Probe::Insert), false);
+
+    if(slot.second)
+    {
+        mData.setValue(slot.first, value);
+        return;
+    }
+
+    int64_t index = slot.first;
+
+    if(isAtLimit())
+    {
+        evict();
+        index = findEmpty(home, hashMetaValue(hash), Probe::Insert);
+    }
+
+    mData.setCount(mData.count() + 1);
+
+    if(isProbeTooLong(index, home, hashMetaValue(hash)) && reseed())
+    {
+        hash = hashKey(key);
+        index = findEmpty(hashIndex(hash, capacity()), hashMetaValue(hash), Probe::Rehash);
+    }
+
+    insertNew(index, key, value, hash);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+std::pair<int64_t, bool> Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::insertUnique(const Key &key, const Value &value, bool assign)
+{
+    allocate();
+    uint64_t hash = hashKey(key);
+    const int64_t home = hashIndex(hash, capacity());
+    const std::pair<int64_t, bool> slot = mayContain(hash) ? findSlot(home, hashMetaValue(hash), hashTag(hash), keyComparator(key, mData)) : std::pair<int64_t, bool>(findEmpty(home, hashMetaValue(hash), Probe::Insert), false);
+
+    if(slot.second)
+    {
+        if(assign)
+            mData.setValue(slot.first, value);
+
+        return {slot.first, false};
+    }
+
+    int64_t index = slot.first;
+
+    if(isAtLimit())
+    {
+        evict();
+        index = findEmpty(home, hashMetaValue(hash), Probe::Insert);
+    }
+
+    mData.setCount(mData.count() + 1);
+
+    if(rehash() || (isProbeTooLong(index, home, hashMetaValue(hash)) && reseed()))
+    {
+        hash = hashKey(key);
+        index = findEmpty(hashIndex(hash, capacity()), hashMetaValue(hash), Probe::Rehash);
+    }
+
+    return {insertNew(index, key, value, hash), true};
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isAdoptable(const Hash &other) const
+{
+    return (!IsStatefulHash<HashFunction, Key>::value || IsSeededHash<HashFunctionType>::value) && filter().bitsPerElement() == other.filter().bitsPerElement() && limit() == other.limit() && wideTags() == other.wideTags();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isBewloMinCount() const
+{
+    return mData.count() < minCount();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isEmpty(int64_t index) const
+{
+    return *mData.metaData(index, 1) == static_cast<char>(MetaValues::Empty);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isFree(int64_t index) const
+{
+    return isEmpty(index) || isDeleted(index);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isAtLimit() const
+{
+    return limit() != 0 && count() >= limit();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isGroupFull(int64_t index) const
+{
+    return matchAligned(static_cast<char>(MetaValues::Empty), mData.metaData(index, GROUP_SIZE)) == 0;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isDeleted(int64_t index) const
+{
+    return *mData.metaData(index, 1) == static_cast<char>(MetaValues::Deleted);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isOverMaxCount() const
+{
+    return mData.count() >= maxCount();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isOverMaxDeletedCount() const
+{
+    return mData.deletedCount() >= maxDeletedCount();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isOverflowed(int64_t index) const
+{
+    return !mOverflows.empty() && mOverflows[static_cast<size_t>(index / GROUP_SIZE)] != 0;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isProbeTooLong(int64_t index, int64_t home, char metaValue) const
+{
+    if(mData.count() >= capacity() / 4 * 3)
+        return false;
+
+    for(int64_t groups = 1; groups <= MAX_PROBE_GROUPS; groups++)
+    {
+        if(groupIndex(index) == home)
+            return false;
+
+        home = nextGroupIndex(home, groups, metaValue);
+    }
+
+    return true;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::isValid(int64_t index) const
+{
+    return (*mData.metaData(index, 1) >> 7) == static_cast<char>(MetaValues::Valid);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Callback>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::joinBatch(const Key *keys, int64_t count, Callback callback) const
+{
+    uint64_t hashes[BATCH_SIZE];
+    int64_t indexes[BATCH_SIZE];
+
+    prefetchBatch(keys, count, hashes, indexes);
+
+    for(int64_t position = 0; position < count; position++)
+        if(mayContain(hashes[position]))
+            findIndexes(keys[position], indexes[position], hashMetaValue(hashes[position]), hashTag(hashes[position]), [&](int64_t index) { callback(position, index); });
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::keyComparator(const Key &key, const DataType &data)
+{
+    return [&key, &data](int64_t index) { return data.key(index) == key; };
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::keyValueComparator(const Key &key, const Value &val, const DataType &data)
+{
+    return [&key, &val, &data](int64_t index) { return data.key(index) == key && data.value(index) == val; };
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::markIndexes(int64_t size)
+{
+    for(int64_t index = 0; index < size; index++)
+    {
+        if(isDeleted(index))
+            setMetaValue(index, MetaValues::Empty);
+        else if(!isFree(index))
+            setMetaValue(index, MetaValues::Deleted);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+uint16_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::matchPositions(int64_t index, char metaValue, char tag) const
+{
+    uint16_t positions = static_cast<uint16_t>(matchAligned(metaValue, mData.metaData(index, GROUP_SIZE)));
+
+    if(positions != 0 && wideTags())
+        positions &= static_cast<uint16_t>(matchAligned(tag, &mExtension->tags[static_cast<size_t>(index)]));
+
+    return positions;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::maxCount() const
+{
+    return capacity() * 15 / 16;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::maxDeletedCount() const
+{
+    return std::max<int64_t>(capacity() / 16, 1);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::mayContain(uint64_t hash) const
+{
+    return count() != 0 && (!mExtension || mExtension->filter.contains(hash));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::minCount() const
+{
+    return capacity() * 7 / 16;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Function>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::modifyAt(int64_t index, Function function)
+{
+    modifyAt(index, function, HasValueData<DataType>());
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Function>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::modifyAt(int64_t index, Function function, std::false_type)
+{
+    Value value = mData.value(index);
+    function(value);
+    mData.setValue(index, std::move(value));
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::rehash(int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename Function>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::modifyAt(int64_t index, Function function, std::true_type)
+{
+    function(*mData.valueData(index));
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::nextGroupIndex(int64_t index, int64_t groups, char metaValue) const
+{
+    return (index + ProbePolicy::step(groups, metaValue) * GROUP_SIZE) % capacity();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+int64_t Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::nextIndex(int64_t index, int64_t size) const
+{
+    return (index + 1) % size;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchBatch(const Key *keys, int64_t count, uint64_t *hashes, int64_t *indexes) const
+{
+    for(int64_t position = 0; position < count; position++)
+    {
+        hashes[position] = hashKey(keys[position]);
+        indexes[position] = capacity() != 0 ? hashIndex(hashes[position], capacity()) : 0;
+    }
+
+    if(capacity() < PREFETCH_CAPACITY)
+        return;
+
+    for(int64_t position = 0; position < count; position++)
+    {
+        if(!mayContain(hashes[position]))
+            continue;
+
+        prefetchMetaData(indexes[position]);
+
+        if(wideTags())
+            adb::prefetch(&mExtension->tags[static_cast<size_t>(indexes[position])]);
+    }
+
+    if(!HasPrefetch<DataType>::value)
+        return;
+
+    for(int64_t position = 0; position < count; position++)
+    {
+        if(!mayContain(hashes[position]))
+            continue;
+
+        const BitMask<uint16_t> positions = findPositions(indexes[position], hashMetaValue(hashes[position]), hashTag(hashes[position]));
+
+        if(!positions.none())
+            prefetchData(dataIndex(indexes[position] + *positions.begin()));
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchData(int64_t index) const
+{
+    prefetchData(index, HasPrefetch<DataType>());
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchData(int64_t index, std::false_type) const
+{
+    (void)index;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchData(int64_t index, std::true_type) const
+{
+    mData.prefetch(index);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchMetaData(int64_t index) const
+{
+    prefetchMetaData(index, HasPrefetchMetaData<DataType>());
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchMetaData(int64_t index, std::false_type) const
+{
+    (void)index;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::prefetchMetaData(int64_t index, std::true_type) const
+{
+    mData.prefetchMetaData(index);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::rehash()
+{
+    const int64_t size = capacity();
+
+    if(size == 0)
+        return false;
+
+    if(isOverMaxCount())
+        grow();
+    else if(isBewloMinCount() && capacity() > GROUP_SIZE)
+        shrink();
+    else if(isOverMaxDeletedCount() || filter().isFull())
+        rehash(capacity());
+    else
+        return false;
+
+    recordRehash(size, capacity());
+    return true;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::rehash(int64_t newSize)
 {
     if(newSize >= GROUP_SIZE)
         rehash(capacity(), newSize);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::rehash(int64_t oldSize, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::rehash(int64_t oldSize, int64_t newSize)
 {
+    if(mExtension)
+        mExtension->filter.reset(newSize);
+    markIndexes(oldSize);
     grow(oldSize, newSize);
-    rehashIndexes(oldSize, newSize);
     squeeze(oldSize, newSize);
+    mOverflows.clear();
+    rehashIndexes(newSize);
+    mData.setDeletedCount(0);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::rehashIndex(int64_t index, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::rehashIndex(int64_t index)
 {
-    if(isDeleted(index))
+    const Key key = mData.key(index);
+    const uint64_t hash = hashKey(key);
+    const int64_t home = hashIndex(hash, capacity());
+    const int64_t newIndex = findEmpty(home, hashMetaValue(hash), Probe::Rehash);
+    if(mExtension)
+        mExtension->filter.insert(hash);
+    updateOverflows(home, newIndex, hashMetaValue(hash), 1);
+
+    if(groupDistance(index, home) == groupDistance(newIndex, home))
+    {
+        setMetaValue(index, hashMetaValue(hash));
+        setTag(index, hash);
+    }
+    else if(isEmpty(newIndex))
+    {
+        insertData(newIndex, key, mData.value(index), hashMetaValue(hash));
+        setTag(newIndex, hash);
         setMetaValue(index, MetaValues::Empty);
-    else if(!isFree(index))
-        reinsert(index, newSize);
+        swapReferences(index, newIndex);
+    }
+    else
+    {
+        const Key otherKey = mData.key(newIndex);
+        const Value otherValue = mData.value(newIndex);
+        insertData(newIndex, key, mData.value(index), hashMetaValue(hash));
+        setTag(newIndex, hash);
+        mData.setData(index, otherKey, otherValue);
+        swapReferences(index, newIndex);
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::rehashIndexes(int64_t size, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::rehashIndexes(int64_t size)
 {
     for(int64_t index = 0; index < size; index++)
-        rehashIndex(index, newSize);
+        while(isDeleted(index))
+            rehashIndex(index);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::recordGroup(int64_t index) const
+{
+#ifdef ADB_STATISTICS
+    mStatistics.probedGroups++;
+
+    if(isGroupFull(index))
+        mStatistics.fullGroups++;
+#else
+    (void)index;
+#endif
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::recordProbe(Probe probe, int64_t groups) const
+{
+#ifdef ADB_STATISTICS
+    if(probe == Probe::Lookup)
+    {
+        mStatistics.lookups++;
+        mStatistics.lookupGroups += groups;
+        mStatistics.maxLookupGroups = std::max(mStatistics.maxLookupGroups, groups);
+    }
+    else if(probe == Probe::Insert)
+    {
+        mStatistics.inserts++;
+        mStatistics.insertGroups += groups;
+        mStatistics.maxInsertGroups = std::max(mStatistics.maxInsertGroups, groups);
+    }
+#else
+    (void)probe;
+    (void)groups;
+#endif
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::recordRehash(int64_t oldSize, int64_t newSize)
+{
+#ifdef ADB_STATISTICS
+    if(newSize > oldSize)
+        mStatistics.grows++;
+    else if(newSize < oldSize)
+        mStatistics.shrinks++;
+    else
+        mStatistics.cleanups++;
+#else
+    (void)oldSize;
+    (void)newSize;
+#endif
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::recordReseed()
+{
+#ifdef ADB_STATISTICS
+    mStatistics.reseeds++;
+#endif
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::resize(int64_t size)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::recordTag(bool match) const
 {
-    mData.setMetaData(mData.dataSize(), std::vector<char>(GROUP_SIZE, static_cast<char>(MetaValues::Empty)));
-    mData.resize(size, size + GROUP_SIZE, static_cast<char>(MetaValues::Empty));
-    mData.setMetaData(size, std::vector<char>(mData.metaData(0, GROUP_SIZE), mData.metaData(0, GROUP_SIZE) + GROUP_SIZE));
+#ifdef ADB_STATISTICS
+    mStatistics.tagMatches++;
+
+    if(!match)
+        mStatistics.tagFalsePositives++;
+#else
+    (void)match;
+#endif
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::setMetaValue(int64_t index, Hash<Key, Value, DataType, HashFunction>::MetaValues value)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::reserve(int64_t count)
+{
+    int64_t size = capacity() != 0 ? capacity() : GROUP_SIZE;
+
+    if(limit() != 0)
+        count = std::min(count, limit());
+
+    while(count >= size * 15 / 16)
+        size *= 2;
+
+    if(size > capacity() && count > 0)
+    {
+        recordRehash(capacity(), size);
+        rehash(size);
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::reseed()
+{
+    return reseed(IsSeededHash<HashFunctionType>());
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::reseed(std::false_type)
+{
+    return false;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::reseed(std::true_type)
+{
+    if(mReseedCapacity == capacity())
+        return false;
+
+    mReseedCapacity = capacity();
+    mHashFunction.setSeed(randomSeed());
+    rehash(capacity());
+    recordReseed();
+    return true;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::reference(int64_t index, bool referenced) const
+{
+    if(limit() != 0)
+        mExtension->references[index].set(referenced);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::resize(int64_t size)
+{
+    mData.resize(size, size, static_cast<char>(MetaValues::Empty));
+
+    if(limit() != 0)
+        mExtension->references.resize(static_cast<size_t>(size));
+
+    if(wideTags())
+        mExtension->tags.resize(static_cast<size_t>(size), 0);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setMetaValue(int64_t index, Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::MetaValues value)
 {
     setMetaValue(index, static_cast<char>(value));
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::setMetaValue(int64_t index, char value)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setMetaValue(int64_t index, char value)
 {
     mData.setMetaValue(index, value);
+}
 
-    if(index < GROUP_SIZE)
-        mData.setMetaValue(mData.dataSize() + index, value);
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::setTag(int64_t index, uint64_t hash)
+{
+    if(wideTags())
+        mExtension->tags[static_cast<size_t>(index)] = hashTag(hash);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::shrink()
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::shrink()
 {
     rehash(capacity() / 2);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-void Hash<Key, Value, DataType, HashFunction>::squeeze(int64_t oldSize, int64_t newSize)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::squeeze(int64_t oldSize, int64_t newSize)
 {
-    if(newSize < oldSize)
-        resize(newSize);
+    if(newSize >= oldSize)
+        return;
+
+    int64_t free = 0;
+
+    for(int64_t index = newSize; index < oldSize; index++)
+    {
+        if(isDeleted(index))
+        {
+            while(!isEmpty(free))
+                free++;
+
+            mData.setData(free, mData.key(index), mData.value(index));
+            setMetaValue(free, MetaValues::Deleted);
+            setMetaValue(index, MetaValues::Empty);
+            swapReferences(index, free);
+        }
+    }
+
+    resize(newSize);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::swapReferences(int64_t index, int64_t other)
+{
+    if(limit() != 0)
+        std::swap(mExtension->references[index], mExtension->references[other]);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
-char Hash<Key, Value, DataType, HashFunction>::takeMetaValue(int64_t index)
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::updateOverflows(int64_t home, int64_t index, char metaValue, int64_t delta)
 {
-    char value = *mData.metaData(index, 1);
-    setMetaValue(index, MetaValues::Empty);
-    return value;
+    if(home != groupIndex(index) && mOverflows.empty())
+        mOverflows.assign(static_cast<size_t>(capacity() / GROUP_SIZE), 0);
+
+    for(int64_t groups = 1; home != groupIndex(index); groups++)
+    {
+        uint8_t &overflow = mOverflows[static_cast<size_t>(home / GROUP_SIZE)];
+
+        if(overflow != MAX_OVERFLOW)
+            overflow = static_cast<uint8_t>(overflow + delta);
+
+        home = nextGroupIndex(home, groups, metaValue);
+    }
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::iterator_base(int64_t index, HashType *hash) :
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::iterator_base(int64_t index, HashType *hash) :
     mIndex(index),
     mHash(hash)
 {
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-auto Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator++() -> iterator_base &
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator++() -> iterator_base &
 {
     mIndex = mHash->findNext(mIndex);
     return *this;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-auto Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator++(int) -> iterator_base
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator++(int) -> iterator_base
 {
     const iterator_base it = *this;
     ++(*this);
     return it;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-auto Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator--() -> iterator_base &
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator--() -> iterator_base &
 {
     mIndex = mHash->findPrevious(mIndex);
     return *this;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-auto Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator--(int) -> iterator_base
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator--(int) -> iterator_base
 {
     const iterator_base it = *this;
     --(*this);
     return it;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-bool Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator==(iterator_base other) const
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator==(iterator_base other) const
 {
     return mIndex == other.mIndex && mHash == other.mHash;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-bool Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator!=(iterator_base other) const
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator!=(iterator_base other) const
 {
     return !(*this == other);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-Key Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::key() const
+Key Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::key() const
 {
     return mHash->mData.key(mIndex);
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::value() const -> value_type
+{
+    return **this;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::iterator_base<ValueType, ReferenceType, HashType>::operator*() const -> reference
+{
+    return reference(mHash->mData, mIndex);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::key_iterator_base(HashType *hash) :
+    mIndex(hash->capacity()),
+    mHash(hash)
+{
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::key_iterator_base(const Key &key, HashType *hash) :
+    mKey(key),
+    mHash(hash)
+{
+    const uint64_t hashValue = mHash->hashKey(key);
+
+    if(!mHash->mayContain(hashValue))
+    {
+        mIndex = mHash->capacity();
+        return;
+    }
+
+    mMetaValue = hashMetaValue(hashValue);
+    mTag = hashTag(hashValue);
+    loadGroup(hashIndex(hashValue, mHash->capacity()));
+    findNext();
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-auto Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::value() const -> value_type
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::operator++() -> key_iterator_base &
+{
+    findNext();
+    return *this;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::operator++(int) -> key_iterator_base
+{
+    const key_iterator_base it = *this;
+    ++(*this);
+    return it;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::operator==(const key_iterator_base &other) const
+{
+    return mIndex == other.mIndex && mHash == other.mHash;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::operator!=(const key_iterator_base &other) const
+{
+    return !(*this == other);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+Key Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::key() const
+{
+    return mKey;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::value() const -> value_type
 {
     return **this;
 }
 
-template<typename Key, typename Value, typename DataType, typename HashFunction>
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
 template<typename ValueType, typename ReferenceType, typename HashType>
-auto Hash<Key, Value, DataType, HashFunction>::iterator_base<ValueType, ReferenceType, HashType>::operator*() const -> reference
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::operator*() const -> reference
 {
     return reference(mHash->mData, mIndex);
 }
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::findNext()
+{
+    while(true)
+    {
+        while(mPositions != 0)
+        {
+            const int64_t index = mHash->dataIndex(mGroupIndex + *BitMask<uint16_t>(mPositions).begin());
+            mPositions &= static_cast<uint16_t>(mPositions - 1);
+            const bool match = mHash->mData.key(index) == mKey;
+            mHash->recordTag(match);
+
+            if(match)
+            {
+                mHash->reference(index, true);
+                mIndex = index;
+                return;
+            }
+        }
+
+        if(!mHash->isGroupFull(mGroupIndex) || !mHash->isOverflowed(mGroupIndex))
+        {
+            mHash->recordProbe(Probe::Lookup, mGroups);
+            mIndex = mHash->capacity();
+            return;
+        }
+
+        loadGroup(mHash->nextGroupIndex(mGroupIndex, mGroups, mMetaValue));
+    }
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+template<typename ValueType, typename ReferenceType, typename HashType>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::key_iterator_base<ValueType, ReferenceType, HashType>::loadGroup(int64_t index)
+{
+    mGroupIndex = index;
+    mPositions = mHash->matchPositions(index, mMetaValue, mTag);
+    mGroups++;
+    mHash->recordGroup(index);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::ReferenceFlag::ReferenceFlag(const ReferenceFlag &other) :
+    mReferenced(other.isSet())
+{
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+auto Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::ReferenceFlag::operator=(const ReferenceFlag &other) -> ReferenceFlag &
+{
+    mReferenced.store(other.isSet(), std::memory_order_relaxed);
+    return *this;
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+bool Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::ReferenceFlag::isSet() const
+{
+    return mReferenced.load(std::memory_order_relaxed);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy>::ReferenceFlag::set(bool referenced)
+{
+    if(isSet() != referenced)
+        mReferenced.store(referenced, std::memory_order_relaxed);
+}
+
+template<typename Key, typename Value, typename DataType, typename HashFunction, typename KeyPolicy, typename ProbePolicy>
+void swap(Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy> &left, Hash<Key, Value, DataType, HashFunction, KeyPolicy, ProbePolicy> &right)
+{
+    left.swap(right);
+}
 }
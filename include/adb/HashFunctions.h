@@ -0,0 +1,278 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace adb
+{
+template<typename HashFunction, typename Key, typename = void>
+struct IsStatefulHash : std::false_type
+{
+};
+
+template<typename HashFunction, typename Key>
+struct IsStatefulHash<HashFunction, Key, decltype(void(std::declval<const HashFunction &>()(std::declval<const Key &>())))> : std::true_type
+{
+};
+
+template<typename HashFunction, typename = void>
+struct IsSeededHash : std::false_type
+{
+};
+
+template<typename HashFunction>
+struct IsSeededHash<HashFunction, decltype(std::declval<HashFunction &>().setSeed(uint64_t()))> : std::true_type
+{
+};
+
+template<typename Value>
+class IntegerHash
+{
+public:
+    constexpr IntegerHash(Value value, uint64_t seed = 0);
+
+    constexpr operator uint64_t() const;
+
+private:
+    uint64_t mValue = 0;
+};
+
+class CStringHash
+{
+public:
+    constexpr CStringHash(const char *value, uint64_t seed = 0);
+
+    constexpr operator uint64_t() const;
+
+private:
+    uint64_t mValue = 0;
+};
+
+class StringHash
+{
+public:
+    StringHash(const std::string &value, uint64_t seed = 0);
+    StringHash(const char *data, int64_t size, uint64_t seed = 0);
+
+    operator uint64_t() const;
+
+private:
+    static uint64_t mix(uint64_t left, uint64_t right);
+    static void multiply(uint64_t &low, uint64_t &high);
+    static uint64_t read(const char *data, int size);
+    static uint64_t readSmall(const char *data, int64_t size);
+
+    static constexpr uint64_t SECRET_0 = 0x2d358dccaa6c78a5ULL;
+    static constexpr uint64_t SECRET_1 = 0x8bb84b93962eacc9ULL;
+    static constexpr uint64_t SECRET_2 = 0x4b33a62ed433d4a3ULL;
+    static constexpr uint64_t SECRET_3 = 0x4d5a2da51de1aa47ULL;
+    uint64_t mValue = 0;
+};
+
+template<typename Key, typename HashFunction>
+class SeededHash
+{
+public:
+    SeededHash();
+    explicit SeededHash(uint64_t seed);
+
+    uint64_t operator()(const Key &key) const;
+    uint64_t seed() const;
+    void setSeed(uint64_t seed);
+
+private:
+    uint64_t mSeed = 0;
+};
+
+inline uint64_t randomSeed()
+{
+    static const uint64_t base = (static_cast<uint64_t>(std::random_device()()) << 32) ^ std::random_device()();
+    static std::atomic<uint64_t> counter(0);
+    const uint64_t time = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return IntegerHash<uint64_t>(time, base + counter.fetch_add(1, std::memory_order_relaxed) * 0x9e3779b97f4a7c15ULL);
+}
+
+template<typename Value>
+constexpr IntegerHash<Value>::IntegerHash(Value value, uint64_t seed) :
+    mValue(static_cast<uint64_t>(value) ^ seed)
+{
+    mValue = (mValue ^ (mValue >> 32)) * 0xd6e8feb86659fd93ULL;
+    mValue = (mValue ^ (mValue >> 32)) * 0xd6e8feb86659fd93ULL;
+    mValue ^= mValue >> 32;
+}
+
+template<typename Value>
+constexpr IntegerHash<Value>::operator uint64_t() const
+{
+    return mValue;
+}
+
+constexpr CStringHash::CStringHash(const char *value, uint64_t seed) :
+    mValue(0xcbf29ce484222325ULL ^ seed)
+{
+    for(; *value != '\0'; value++)
+        mValue = (mValue ^ static_cast<unsigned char>(*value)) * 0x100000001b3ULL;
+
+    mValue = IntegerHash<uint64_t>(mValue);
+}
+
+constexpr CStringHash::operator uint64_t() const
+{
+    return mValue;
+}
+
+inline StringHash::StringHash(const std::string &value, uint64_t seed) :
+    StringHash(value.data(), static_cast<int64_t>(value.size()), seed)
+{
+}
+
+inline StringHash::StringHash(const char *data, int64_t size, uint64_t seed)
+{
+    seed ^= mix(seed ^ SECRET_0, SECRET_1);
+    uint64_t first = 0;
+    uint64_t second = 0;
+
+    if(size <= 16)
+    {
+        if(size >= 4)
+        {
+            const int64_t offset = (size >> 3) << 2;
+            first = (read(data, 4) << 32) | read(data + offset, 4);
+            second = (read(data + size - 4, 4) << 32) | read(data + size - 4 - offset, 4);
+        }
+        else
+        {
+            first = readSmall(data, size);
+        }
+    }
+    else
+    {
+        int64_t remaining = size;
+
+        if(remaining > 48)
+        {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+
+            do
+            {
+                seed = mix(read(data, 8) ^ SECRET_1, read(data + 8, 8) ^ seed);
+                seed1 = mix(read(data + 16, 8) ^ SECRET_2, read(data + 24, 8) ^ seed1);
+                seed2 = mix(read(data + 32, 8) ^ SECRET_3, read(data + 40, 8) ^ seed2);
+                data += 48;
+                remaining -= 48;
+            } while(remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while(remaining > 16)
+        {
+            seed = mix(read(data, 8) ^ SECRET_1, read(data + 8, 8) ^ seed);
+            data += 16;
+            remaining -= 16;
+        }
+
+        first = read(data + remaining - 16, 8);
+        second = read(data + remaining - 8, 8);
+    }
+
+    first ^= SECRET_1;
+    second ^= seed;
+    multiply(first, second);
+    mValue = mix(first ^ SECRET_0 ^ static_cast<uint64_t>(size), second ^ SECRET_1);
+}
+
+inline uint64_t StringHash::mix(uint64_t left, uint64_t right)
+{
+    multiply(left, right);
+    return left ^ right;
+}
+
+inline void StringHash::multiply(uint64_t &low, uint64_t &high)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 result = static_cast<unsigned __int128>(low) * high;
+    low = static_cast<uint64_t>(result);
+    high = static_cast<uint64_t>(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    low = _umul128(low, high, &high);
+#else
+    const uint64_t lowLow = (low & 0xFFFFFFFF) * (high & 0xFFFFFFFF);
+    const uint64_t highLow = (low >> 32) * (high & 0xFFFFFFFF);
+    const uint64_t lowHigh = (low & 0xFFFFFFFF) * (high >> 32);
+    const uint64_t highHigh = (low >> 32) * (high >> 32);
+    const uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+    low = (cross << 32) | (lowLow & 0xFFFFFFFF);
+    high = (highLow >> 32) + (cross >> 32) + highHigh;
+#endif
+}
+
+inline StringHash::operator uint64_t() const
+{
+    return mValue;
+}
+
+inline uint64_t StringHash::read(const char *data, int size)
+{
+    if(size == 4)
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t StringHash::readSmall(const char *data, int64_t size)
+{
+    if(size == 0)
+        return 0;
+
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    return (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[size >> 1]) << 8) | bytes[size - 1];
+}
+
+template<typename Key, typename HashFunction>
+SeededHash<Key, HashFunction>::SeededHash() :
+    mSeed(randomSeed())
+{
+}
+
+template<typename Key, typename HashFunction>
+SeededHash<Key, HashFunction>::SeededHash(uint64_t seed) :
+    mSeed(seed)
+{
+}
+
+template<typename Key, typename HashFunction>
+uint64_t SeededHash<Key, HashFunction>::operator()(const Key &key) const
+{
+    return HashFunction(key, mSeed);
+}
+
+template<typename Key, typename HashFunction>
+uint64_t SeededHash<Key, HashFunction>::seed() const
+{
+    return mSeed;
+}
+
+template<typename Key, typename HashFunction>
+void SeededHash<Key, HashFunction>::setSeed(uint64_t seed)
+{
+    mSeed = seed;
+}
+}
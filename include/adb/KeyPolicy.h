@@ -0,0 +1,12 @@
+#pragma once
+
+namespace adb
+{
+struct MultiKey
+{
+};
+
+struct UniqueKey
+{
+};
+}
@@ -0,0 +1,499 @@
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "DataTraits.h"
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace adb
+{
+template<typename Key, typename Value, int64_t PageSize = 4096>
+class PagedData
+{
+public:
+    PagedData(int64_t dataSize, int64_t metaSize, char metaValue, std::string fileName, int64_t cacheSize);
+    PagedData(const PagedData &other) = delete;
+    PagedData(PagedData &&other);
+    ~PagedData();
+
+    int64_t cacheSize() const;
+    int64_t count() const;
+    int64_t dataSize() const;
+    int64_t deletedCount() const;
+    Key key(int64_t index) const;
+    int64_t memoryUsage() const;
+    const char *metaData(int64_t index, int64_t size) const;
+    int64_t metaSize() const;
+    void prefetch(int64_t index) const;
+    void prefetchMetaData(int64_t index) const;
+    void resize(int64_t dataSize, int64_t metaSize, char metaValue);
+    void setCount(int64_t count);
+    void setData(int64_t index, const Key &key, const Value &value);
+    void setDeletedCount(int64_t count);
+    void setMetaData(int64_t index, const std::vector<char> &values);
+    void setMetaValue(int64_t index, char value);
+    void setValue(int64_t index, const Value &value);
+    Value value(int64_t index) const;
+
+    PagedData &operator=(const PagedData &other) = delete;
+    PagedData &operator=(PagedData &&other);
+
+private:
+    struct Node
+    {
+        Key key = {};
+        Value value = {};
+    };
+
+    struct Frame
+    {
+        int64_t page = -1;
+        int weight = 0;
+        bool dirty = false;
+        std::vector<char, AlignedAllocator<char, 64>> data;
+    };
+
+    static_assert(PageSize >= 64 && PageSize % 64 == 0, "PageSize must be a multiple of 64");
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "Key and Value must be trivially copyable");
+
+    static constexpr int64_t SEGMENT_PAGES = 1 + static_cast<int64_t>(sizeof(Node));
+    static constexpr int DATA_WEIGHT = 1;
+    static constexpr int META_WEIGHT = 3;
+
+    void advise(int64_t offset, int64_t size) const;
+    void close();
+    int64_t evict() const;
+    void fillMetaData(int64_t from, int64_t to, char metaValue);
+    char *load(int64_t page, int weight, bool dirty) const;
+    static int64_t metaOffset(int64_t index);
+    static int64_t nodeOffset(int64_t index);
+    Node node(int64_t index) const;
+    int open() const;
+    void read(int64_t offset, char *data, int64_t size) const;
+    void readPage(Frame &frame) const;
+    void reset(int64_t frames);
+    static int64_t segmentCount(int64_t dataSize, int64_t metaSize);
+    void setNode(int64_t index, const Node &node);
+    void truncate(int64_t pages);
+    void write(int64_t offset, const char *data, int64_t size);
+    void writePage(const Frame &frame) const;
+
+    int64_t mCount = 0;
+    int64_t mDeletedCount = 0;
+    int64_t mDataSize = 0;
+    int64_t mMetaSize = 0;
+    std::string mFileName;
+    mutable int mFile = -1;
+    mutable int64_t mClock = 0;
+    mutable std::vector<Frame> mFrames;
+    mutable std::unordered_map<int64_t, int64_t> mPages;
+};
+
+template<typename Key, typename Value, int64_t PageSize>
+PagedData<Key, Value, PageSize>::PagedData(int64_t dataSize, int64_t metaSize, char metaValue, std::string fileName, int64_t cacheSize) :
+    mFileName(std::move(fileName)),
+    mFrames(static_cast<size_t>(std::max<int64_t>(cacheSize / PageSize, 2)))
+{
+    resize(dataSize, metaSize, metaValue);
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+PagedData<Key, Value, PageSize>::PagedData(PagedData &&other) :
+    mCount(other.mCount),
+    mDeletedCount(other.mDeletedCount),
+    mDataSize(other.mDataSize),
+    mMetaSize(other.mMetaSize),
+    mFileName(other.mFileName),
+    mFile(other.mFile),
+    mClock(other.mClock),
+    mFrames(std::move(other.mFrames)),
+    mPages(std::move(other.mPages))
+{
+    other.reset(static_cast<int64_t>(mFrames.size()));
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+PagedData<Key, Value, PageSize>::~PagedData()
+{
+    close();
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::cacheSize() const
+{
+    return static_cast<int64_t>(mFrames.size()) * PageSize;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::count() const
+{
+    return mCount;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::dataSize() const
+{
+    return mDataSize;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::deletedCount() const
+{
+    return mDeletedCount;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+Key PagedData<Key, Value, PageSize>::key(int64_t index) const
+{
+    return node(index).key;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+const char *PagedData<Key, Value, PageSize>::metaData(int64_t index, int64_t size) const
+{
+    (void)size;
+    return load(metaOffset(index) / PageSize, META_WEIGHT, false) + index % PageSize;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::memoryUsage() const
+{
+    int64_t usage = static_cast<int64_t>(mFrames.size() * sizeof(Frame) + mPages.size() * sizeof(std::pair<const int64_t, int64_t>) + mPages.bucket_count() * sizeof(void *));
+
+    for(const Frame &frame : mFrames)
+        usage += static_cast<int64_t>(frame.data.capacity());
+
+    return usage;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::metaSize() const
+{
+    return mMetaSize;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::prefetch(int64_t index) const
+{
+    advise(nodeOffset(index), sizeof(Node));
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::prefetchMetaData(int64_t index) const
+{
+    advise(metaOffset(index), 1);
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::resize(int64_t dataSize, int64_t metaSize, char metaValue)
+{
+    const int64_t oldMetaSize = mMetaSize;
+    truncate(segmentCount(dataSize, metaSize) * SEGMENT_PAGES);
+    mDataSize = dataSize;
+    mMetaSize = metaSize;
+    fillMetaData(oldMetaSize, metaSize, metaValue);
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setCount(int64_t count)
+{
+    mCount = count;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setData(int64_t index, const Key &key, const Value &value)
+{
+    setNode(index, Node{key, value});
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setDeletedCount(int64_t count)
+{
+    mDeletedCount = count;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setMetaData(int64_t index, const std::vector<char> &values)
+{
+    for(char value : values)
+        setMetaValue(index++, value);
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setMetaValue(int64_t index, char value)
+{
+    load(metaOffset(index) / PageSize, META_WEIGHT, true)[index % PageSize] = value;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setValue(int64_t index, const Value &value)
+{
+    Node data = node(index);
+    data.value = value;
+    setNode(index, data);
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+Value PagedData<Key, Value, PageSize>::value(int64_t index) const
+{
+    return node(index).value;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+PagedData<Key, Value, PageSize> &PagedData<Key, Value, PageSize>::operator=(PagedData &&other)
+{
+    if(this != &other)
+    {
+        close();
+        mCount = other.mCount;
+        mDeletedCount = other.mDeletedCount;
+        mDataSize = other.mDataSize;
+        mMetaSize = other.mMetaSize;
+        mFileName = other.mFileName;
+        mFile = other.mFile;
+        mClock = other.mClock;
+        mFrames = std::move(other.mFrames);
+        mPages = std::move(other.mPages);
+        other.reset(static_cast<int64_t>(mFrames.size()));
+    }
+
+    return *this;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::advise(int64_t offset, int64_t size) const
+{
+#ifdef POSIX_FADV_WILLNEED
+    if(mFile != -1 && mPages.find(offset / PageSize) == mPages.end())
+        ::posix_fadvise(mFile, static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#else
+    (void)offset;
+    (void)size;
+#endif
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::close()
+{
+    if(mFile != -1)
+        ::close(mFile);
+
+    mFile = -1;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::evict() const
+{
+    for(;; mClock = (mClock + 1) % static_cast<int64_t>(mFrames.size()))
+    {
+        Frame &frame = mFrames[mClock];
+
+        if(frame.page == -1 || frame.weight == 0)
+        {
+            const int64_t index = mClock;
+            mClock = (mClock + 1) % static_cast<int64_t>(mFrames.size());
+            return index;
+        }
+
+        frame.weight--;
+    }
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::fillMetaData(int64_t from, int64_t to, char metaValue)
+{
+    while(from < to)
+    {
+        const int64_t size = std::min(to - from, PageSize - from % PageSize);
+        std::memset(load(metaOffset(from) / PageSize, META_WEIGHT, true) + from % PageSize, metaValue, static_cast<size_t>(size));
+        from += size;
+    }
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+char *PagedData<Key, Value, PageSize>::load(int64_t page, int weight, bool dirty) const
+{
+    const auto it = mPages.find(page);
+
+    if(it != mPages.end())
+    {
+        Frame &frame = mFrames[it->second];
+        frame.weight = std::max(frame.weight, weight);
+        frame.dirty = frame.dirty || dirty;
+        return frame.data.data();
+    }
+
+    const int64_t index = evict();
+    Frame &frame = mFrames[index];
+
+    if(frame.page != -1)
+    {
+        if(frame.dirty)
+            writePage(frame);
+
+        mPages.erase(frame.page);
+    }
+
+    frame.data.resize(PageSize);
+    frame.page = page;
+    frame.weight = weight;
+    frame.dirty = dirty;
+    readPage(frame);
+    mPages[page] = index;
+    return frame.data.data();
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::metaOffset(int64_t index)
+{
+    return index / PageSize * SEGMENT_PAGES * PageSize + index % PageSize;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::nodeOffset(int64_t index)
+{
+    return (index / PageSize * SEGMENT_PAGES + 1) * PageSize + index % PageSize * static_cast<int64_t>(sizeof(Node));
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+auto PagedData<Key, Value, PageSize>::node(int64_t index) const -> Node
+{
+    Node data;
+    read(nodeOffset(index), reinterpret_cast<char *>(&data), sizeof(Node));
+    return data;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int PagedData<Key, Value, PageSize>::open() const
+{
+    if(mFile == -1)
+    {
+        mFile = ::open(mFileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+        if(mFile == -1)
+            throw std::system_error(errno, std::generic_category(), "adb::PagedData: cannot open " + mFileName);
+
+        ::unlink(mFileName.c_str());
+    }
+
+    return mFile;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::read(int64_t offset, char *data, int64_t size) const
+{
+    while(size > 0)
+    {
+        const int64_t part = std::min(size, PageSize - offset % PageSize);
+        std::memcpy(data, load(offset / PageSize, DATA_WEIGHT, false) + offset % PageSize, static_cast<size_t>(part));
+        offset += part;
+        data += part;
+        size -= part;
+    }
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::readPage(Frame &frame) const
+{
+    int64_t done = 0;
+
+    while(mFile != -1 && done < PageSize)
+    {
+        const ssize_t result = ::pread(mFile, frame.data.data() + done, static_cast<size_t>(PageSize - done), static_cast<off_t>(frame.page * PageSize + done));
+
+        if(result == 0)
+            break;
+
+        if(result < 0 && errno != EINTR)
+            throw std::system_error(errno, std::generic_category(), "adb::PagedData: cannot read " + mFileName);
+
+        done += std::max<ssize_t>(result, 0);
+    }
+
+    std::memset(frame.data.data() + done, 0, static_cast<size_t>(PageSize - done));
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::reset(int64_t frames)
+{
+    mCount = 0;
+    mDeletedCount = 0;
+    mDataSize = 0;
+    mMetaSize = 0;
+    mFile = -1;
+    mClock = 0;
+    mFrames = std::vector<Frame>(static_cast<size_t>(frames));
+    mPages.clear();
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+int64_t PagedData<Key, Value, PageSize>::segmentCount(int64_t dataSize, int64_t metaSize)
+{
+    return (std::max(dataSize, metaSize) + PageSize - 1) / PageSize;
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::setNode(int64_t index, const Node &node)
+{
+    write(nodeOffset(index), reinterpret_cast<const char *>(&node), sizeof(Node));
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::truncate(int64_t pages)
+{
+    for(Frame &frame : mFrames)
+    {
+        if(frame.page >= pages)
+        {
+            mPages.erase(frame.page);
+            frame = Frame{-1, 0, false, std::move(frame.data)};
+        }
+    }
+
+    if(mFile != -1 && ::ftruncate(mFile, static_cast<off_t>(pages * PageSize)) != 0)
+        throw std::system_error(errno, std::generic_category(), "adb::PagedData: cannot resize " + mFileName);
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::write(int64_t offset, const char *data, int64_t size)
+{
+    while(size > 0)
+    {
+        const int64_t part = std::min(size, PageSize - offset % PageSize);
+        std::memcpy(load(offset / PageSize, DATA_WEIGHT, true) + offset % PageSize, data, static_cast<size_t>(part));
+        offset += part;
+        data += part;
+        size -= part;
+    }
+}
+
+template<typename Key, typename Value, int64_t PageSize>
+void PagedData<Key, Value, PageSize>::writePage(const Frame &frame) const
+{
+    const int file = open();
+    int64_t done = 0;
+
+    while(done < PageSize)
+    {
+        const ssize_t result = ::pwrite(file, frame.data.data() + done, static_cast<size_t>(PageSize - done), static_cast<off_t>(frame.page * PageSize + done));
+
+        if(result < 0 && errno != EINTR)
+            throw std::system_error(errno, std::generic_category(), "adb::PagedData: cannot write " + mFileName);
+
+        done += std::max<ssize_t>(result, 0);
+    }
+}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace adb
+{
+struct LinearProbe
+{
+    static int64_t step(int64_t groups, char metaValue);
+};
+
+struct TriangularProbe
+{
+    static int64_t step(int64_t groups, char metaValue);
+};
+
+struct DoubleHashProbe
+{
+    static int64_t step(int64_t groups, char metaValue);
+};
+
+inline int64_t LinearProbe::step(int64_t groups, char metaValue)
+{
+    (void)groups;
+    (void)metaValue;
+    return 1;
+}
+
+inline int64_t TriangularProbe::step(int64_t groups, char metaValue)
+{
+    (void)metaValue;
+    return groups;
+}
+
+inline int64_t DoubleHashProbe::step(int64_t groups, char metaValue)
+{
+    (void)groups;
+    return static_cast<int64_t>(metaValue) * 2 + 1;
+}
+}
@@ -6,9 +6,26 @@
 namespace adb
 {
 inline int match(char byte, const char *data)
+{
+    const __m128i m = _mm_set1_epi8(byte);
+    const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(m, ctrl));
+}
+
+inline int matchAligned(char byte, const char *data)
 {
     const __m128i m = _mm_set1_epi8(byte);
     const __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i *>(data));
     return _mm_movemask_epi8(_mm_cmpeq_epi8(m, ctrl));
 }
+
+inline int matchNegativeAligned(const char *data)
+{
+    return _mm_movemask_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(data)));
+}
+
+inline void prefetch(const char *data)
+{
+    _mm_prefetch(data, _MM_HINT_T0);
+}
 }
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "HashFunctions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace adb
+{
+template<typename Key, typename Value>
+struct StaticEntry
+{
+    Key key;
+    Value value;
+};
+
+constexpr int64_t staticHashCapacity(int64_t size)
+{
+    int64_t capacity = 1;
+
+    while(capacity < size * 2)
+        capacity *= 2;
+
+    return capacity;
+}
+
+template<typename Key>
+using StaticHashFunction = typename std::conditional<std::is_same<Key, const char *>::value, CStringHash, IntegerHash<Key>>::type;
+
+template<std::size_t Size>
+using StaticHashIndex = typename std::conditional<Size <= UINT8_MAX, uint8_t, typename std::conditional<Size <= UINT16_MAX, uint16_t, typename std::conditional<Size <= UINT32_MAX, uint32_t, uint64_t>::type>::type>::type;
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction = StaticHashFunction<Key>>
+class StaticHash
+{
+public:
+    using const_iterator = const StaticEntry<Key, Value> *;
+
+    constexpr explicit StaticHash(const StaticEntry<Key, Value> (&entries)[Size]);
+
+    constexpr const_iterator begin() const;
+    constexpr bool contains(const Key &key) const;
+    constexpr int64_t count() const;
+    constexpr const_iterator end() const;
+    constexpr const_iterator find(const Key &key) const;
+    constexpr Value value(const Key &key, const Value &defaultValue = Value()) const;
+
+private:
+    static constexpr bool isEqual(const Key &left, const Key &right);
+    static constexpr bool isEqual(const Key &left, const Key &right, std::false_type);
+    static constexpr bool isEqual(const char *left, const char *right, std::true_type);
+    static constexpr int64_t slot(const Key &key, uint64_t seed);
+
+    using Index = StaticHashIndex<Size>;
+
+    static_assert(Size > 0, "adb::StaticHash requires at least one entry");
+    static constexpr int64_t CAPACITY = staticHashCapacity(static_cast<int64_t>(Size));
+    static_assert(CAPACITY <= INT32_MAX, "adb::StaticHash has too many entries");
+    static constexpr int64_t MAX_DISPLACEMENT = 1 << 20;
+    StaticEntry<Key, Value> mEntries[Size] = {};
+    int32_t mDisplacements[CAPACITY] = {};
+    Index mSlots[CAPACITY] = {};
+};
+
+template<typename Key, typename Value, typename HashFunction = StaticHashFunction<Key>, std::size_t Size>
+constexpr StaticHash<Key, Value, Size, HashFunction> makeStaticHash(const StaticEntry<Key, Value> (&entries)[Size])
+{
+    return StaticHash<Key, Value, Size, HashFunction>(entries);
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr StaticHash<Key, Value, Size, HashFunction>::StaticHash(const StaticEntry<Key, Value> (&entries)[Size])
+{
+    int64_t buckets[Size] = {};
+    int64_t bucketStarts[CAPACITY + 1] = {};
+    int64_t bucketEntries[Size] = {};
+    int64_t maxBucketSize = 0;
+
+    for(int64_t index = 0; index < static_cast<int64_t>(Size); index++)
+    {
+        mEntries[index] = entries[index];
+        buckets[index] = slot(entries[index].key, 0);
+        bucketStarts[buckets[index]]++;
+    }
+
+    for(int64_t bucket = 0; bucket < CAPACITY; bucket++)
+    {
+        if(bucketStarts[bucket] > maxBucketSize)
+            maxBucketSize = bucketStarts[bucket];
+
+        if(bucket > 0)
+            bucketStarts[bucket] += bucketStarts[bucket - 1];
+    }
+
+    bucketStarts[CAPACITY] = static_cast<int64_t>(Size);
+
+    for(int64_t index = static_cast<int64_t>(Size) - 1; index >= 0; index--)
+        bucketEntries[--bucketStarts[buckets[index]]] = index;
+
+    for(int64_t bucket = 0; bucket < CAPACITY; bucket++)
+        for(int64_t entry = bucketStarts[bucket] + 1; entry < bucketStarts[bucket + 1]; entry++)
+            for(int64_t other = bucketStarts[bucket]; other < entry; other++)
+                if(isEqual(mEntries[bucketEntries[entry]].key, mEntries[bucketEntries[other]].key))
+                    throw std::invalid_argument("adb::StaticHash: duplicate key");
+
+    for(Index &index : mSlots)
+        index = static_cast<Index>(Size);
+
+    int64_t placed[Size] = {};
+
+    for(int64_t bucketSize = maxBucketSize; bucketSize > 1; bucketSize--)
+    {
+        for(int64_t bucket = 0; bucket < CAPACITY; bucket++)
+        {
+            if(bucketStarts[bucket + 1] - bucketStarts[bucket] != bucketSize)
+                continue;
+
+            for(int64_t displacement = 1; mDisplacements[bucket] == 0; displacement++)
+            {
+                if(displacement > MAX_DISPLACEMENT)
+                    throw std::logic_error("adb::StaticHash: no perfect placement found");
+
+                int64_t placedCount = 0;
+
+                for(; placedCount < bucketSize; placedCount++)
+                {
+                    const int64_t index = bucketEntries[bucketStarts[bucket] + placedCount];
+                    const int64_t position = slot(mEntries[index].key, static_cast<uint64_t>(displacement));
+
+                    if(mSlots[position] != Size)
+                        break;
+
+                    mSlots[position] = static_cast<Index>(index);
+                    placed[placedCount] = position;
+                }
+
+                if(placedCount == bucketSize)
+                    mDisplacements[bucket] = static_cast<int32_t>(displacement);
+                else
+                    for(int64_t i = 0; i < placedCount; i++)
+                        mSlots[placed[i]] = static_cast<Index>(Size);
+            }
+        }
+    }
+
+    int64_t position = 0;
+
+    for(int64_t index = 0; index < static_cast<int64_t>(Size); index++)
+    {
+        if(bucketStarts[buckets[index] + 1] - bucketStarts[buckets[index]] != 1)
+            continue;
+
+        while(mSlots[position] != Size)
+            position++;
+
+        mSlots[position] = static_cast<Index>(index);
+        mDisplacements[buckets[index]] = static_cast<int32_t>(-position - 1);
+    }
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr auto StaticHash<Key, Value, Size, HashFunction>::begin() const -> const_iterator
+{
+    return mEntries;
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr bool StaticHash<Key, Value, Size, HashFunction>::contains(const Key &key) const
+{
+    return find(key) != end();
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr int64_t StaticHash<Key, Value, Size, HashFunction>::count() const
+{
+    return static_cast<int64_t>(Size);
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr auto StaticHash<Key, Value, Size, HashFunction>::end() const -> const_iterator
+{
+    return mEntries + Size;
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr auto StaticHash<Key, Value, Size, HashFunction>::find(const Key &key) const -> const_iterator
+{
+    const int64_t displacement = mDisplacements[slot(key, 0)];
+    const const_iterator entry = mEntries + mSlots[displacement < 0 ? -displacement - 1 : slot(key, static_cast<uint64_t>(displacement))];
+    return entry != end() && isEqual(entry->key, key) ? entry : end();
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr bool StaticHash<Key, Value, Size, HashFunction>::isEqual(const Key &left, const Key &right)
+{
+    return isEqual(left, right, std::is_same<Key, const char *>());
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr bool StaticHash<Key, Value, Size, HashFunction>::isEqual(const Key &left, const Key &right, std::false_type)
+{
+    return left == right;
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr bool StaticHash<Key, Value, Size, HashFunction>::isEqual(const char *left, const char *right, std::true_type)
+{
+    while(*left != '\0' && *left == *right)
+    {
+        left++;
+        right++;
+    }
+
+    return *left == *right;
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr int64_t StaticHash<Key, Value, Size, HashFunction>::slot(const Key &key, uint64_t seed)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(HashFunction(key, seed)) % static_cast<uint64_t>(CAPACITY));
+}
+
+template<typename Key, typename Value, std::size_t Size, typename HashFunction>
+constexpr Value StaticHash<Key, Value, Size, HashFunction>::value(const Key &key, const Value &defaultValue) const
+{
+    const const_iterator it = find(key);
+    return it != end() ? it->value : defaultValue;
+}
+}
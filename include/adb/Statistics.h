@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+namespace adb
+{
+struct Statistics
+{
+    double falsePositiveRate() const;
+    double fullGroupRatio() const;
+
+    int64_t count = 0;
+    int64_t capacity = 0;
+    int64_t deletedCount = 0;
+    double loadFactor = 0;
+    int64_t lookups = 0;
+    int64_t lookupGroups = 0;
+    int64_t maxLookupGroups = 0;
+    int64_t inserts = 0;
+    int64_t insertGroups = 0;
+    int64_t maxInsertGroups = 0;
+    int64_t probedGroups = 0;
+    int64_t fullGroups = 0;
+    int64_t tagMatches = 0;
+    int64_t tagFalsePositives = 0;
+    int64_t grows = 0;
+    int64_t shrinks = 0;
+    int64_t cleanups = 0;
+    int64_t reseeds = 0;
+};
+
+inline double Statistics::falsePositiveRate() const
+{
+    return tagMatches != 0 ? static_cast<double>(tagFalsePositives) / tagMatches : 0;
+}
+
+inline double Statistics::fullGroupRatio() const
+{
+    return probedGroups != 0 ? static_cast<double>(fullGroups) / probedGroups : 0;
+}
+}
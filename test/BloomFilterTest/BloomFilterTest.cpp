@@ -0,0 +1,149 @@
+#include "BloomFilterTest.h"
+
+#include <BloomFilter.h>
+#include <QTest>
+#include <TestExtras.h>
+
+QTEST_APPLESS_MAIN(adb::BloomFilterTest)
+
+namespace adb
+{
+void BloomFilterTest::contains()
+{
+    QFETCH(qint64, value);
+    QFETCH(qint64, size);
+    QFETCH(qint64, count);
+
+    BloomFilter filter(value);
+    filter.reset(size);
+
+    for(qint64 hash = 0; hash < count; hash++)
+        filter.insert(static_cast<uint64_t>(hash));
+
+    for(qint64 hash = 0; hash < count; hash++)
+        QVERIFY(filter.contains(static_cast<uint64_t>(hash)));
+
+    QCOMPARE(filter.count(), filter.isEnabled() && size > 0 ? count : qint64(0));
+}
+
+void BloomFilterTest::contains_data()
+{
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(SIZE);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Disabled filter should contain everything") << qint64(0) << qint64(1000) << qint64(100);
+    QTest::newRow("Filter of no size should contain everything") << qint64(10) << qint64(0) << qint64(100);
+    QTest::newRow("Filter should contain every inserted hash") << qint64(10) << qint64(1000) << qint64(1000);
+    QTest::newRow("Overfilled filter should contain every inserted hash") << qint64(1) << qint64(100) << qint64(10000);
+}
+
+void BloomFilterTest::falsePositives()
+{
+    QFETCH(qint64, value);
+    QFETCH(qint64, count);
+    QFETCH(qint64, result);
+
+    BloomFilter filter(value);
+    filter.reset(count);
+
+    for(qint64 hash = 0; hash < count; hash++)
+        filter.insert(static_cast<uint64_t>(hash));
+
+    qint64 falsePositives = 0;
+
+    for(qint64 hash = count; hash < count * 11; hash++)
+        falsePositives += filter.contains(static_cast<uint64_t>(hash)) ? 1 : 0;
+
+    QVERIFY(falsePositives * 1000 <= count * 10 * result);
+}
+
+void BloomFilterTest::falsePositives_data()
+{
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Filter with 8 bits per element should reject at least 96% of absent hashes") << qint64(8) << qint64(100000) << qint64(40);
+    QTest::newRow("Filter with 16 bits per element should reject at least 99.8% of absent hashes") << qint64(16) << qint64(100000) << qint64(2);
+}
+
+void BloomFilterTest::isFull()
+{
+    QFETCH(qint64, value);
+    QFETCH(qint64, count);
+    QFETCH(bool, result);
+
+    BloomFilter filter(value);
+    filter.reset(100);
+
+    for(qint64 hash = 0; hash < count; hash++)
+        filter.insert(static_cast<uint64_t>(hash));
+
+    QCOMPARE(filter.isFull(), result);
+}
+
+void BloomFilterTest::isFull_data()
+{
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Disabled filter should never be full") << qint64(0) << qint64(1000) << false;
+    QTest::newRow("Filter with up to its size elements should not be full") << qint64(10) << qint64(100) << false;
+    QTest::newRow("Filter with more than its size elements should be full") << qint64(10) << qint64(101) << true;
+}
+
+void BloomFilterTest::memoryUsage()
+{
+    QFETCH(qint64, value);
+    QFETCH(qint64, size);
+    QFETCH(qint64, result);
+
+    BloomFilter filter(value);
+    filter.reset(size);
+
+    QCOMPARE(filter.memoryUsage(), result);
+}
+
+void BloomFilterTest::memoryUsage_data()
+{
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(SIZE);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Disabled filter should use no memory") << qint64(0) << qint64(1000) << qint64(0);
+    QTest::newRow("Filter should use bits per element times size rounded up to 64 byte blocks") << qint64(10) << qint64(100) << qint64(128);
+    QTest::newRow("Filter of exact blocks should not round up") << qint64(8) << qint64(512) << qint64(512);
+}
+
+void BloomFilterTest::reset()
+{
+    QFETCH(qint64, value);
+    QFETCH(qint64, size);
+
+    BloomFilter filter(value);
+    filter.reset(100);
+
+    for(qint64 hash = 0; hash < 100; hash++)
+        filter.insert(static_cast<uint64_t>(hash));
+
+    filter.reset(size);
+
+    QCOMPARE(filter.bitsPerElement(), value);
+    QCOMPARE(filter.size(), size);
+    QCOMPARE(filter.count(), qint64(0));
+
+    for(qint64 hash = 0; hash < 100; hash++)
+        QVERIFY(!filter.contains(static_cast<uint64_t>(hash)));
+}
+
+void BloomFilterTest::reset_data()
+{
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(SIZE);
+
+    QTest::newRow("Reset filter should contain nothing") << qint64(10) << qint64(100);
+    QTest::newRow("Reset filter of different size should contain nothing") << qint64(10) << qint64(10000);
+}
+}
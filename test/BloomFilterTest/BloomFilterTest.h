@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QObject>
+
+namespace adb
+{
+class BloomFilterTest : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+private slots:
+    void contains();
+    void contains_data();
+    void falsePositives();
+    void falsePositives_data();
+    void isFull();
+    void isFull_data();
+    void memoryUsage();
+    void memoryUsage_data();
+    void reset();
+    void reset_data();
+};
+}
@@ -88,6 +88,20 @@ void DataTest::dataSize_data()
     QTest::newRow("Data with values should have original construction size") << Setup::Data << DATA_SIZE;
 }
 
+void DataTest::deletedCount()
+{
+    QTEST(mData.deletedCount(), COUNT);
+}
+
+void DataTest::deletedCount_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(COUNT);
+
+    QTest::newRow("Empty data should have 0 deleted count") << Setup::Empty << int64_t(0);
+    QTest::newRow("Data with values should have 0 deleted count") << Setup::Data << int64_t(0);
+}
+
 void DataTest::key()
 {
     QFETCH(int64_t, index);
@@ -124,6 +138,21 @@ void DataTest::metaData_data()
     QTest::newRow("Meta values of data with values should have correct value") << Setup::Data << int64_t(1) << int64_t(16) << QByteArray::fromRawData(META_VALUES.data() + 1, 16);
 }
 
+void DataTest::metaDataAlignment()
+{
+    QCOMPARE(reinterpret_cast<uintptr_t>(mData.metaData(0, 16)) % 64, uintptr_t(0));
+    mData.resize(mData.dataSize() * 2 + 1, mData.metaSize() * 2 + 1, 1);
+    QCOMPARE(reinterpret_cast<uintptr_t>(mData.metaData(0, 16)) % 64, uintptr_t(0));
+}
+
+void DataTest::metaDataAlignment_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+
+    QTest::newRow("Meta data of default constructed data should be aligned to 64 bytes") << Setup::Empty;
+    QTest::newRow("Meta data of data with values should be aligned to 64 bytes") << Setup::Data;
+}
+
 void DataTest::metaSize()
 {
     QTEST(mData.metaSize(), SIZE_META);
@@ -205,6 +234,25 @@ void DataTest::setData_data()
     QTest::newRow("Set value in data with values overwrites the existing value") << Setup::Data << int64_t(1) << -10 << -100;
 }
 
+void DataTest::setDeletedCount()
+{
+    QFETCH(int64_t, count);
+
+    const int64_t oldCount = mData.count();
+    mData.setDeletedCount(count);
+    QCOMPARE(mData.deletedCount(), count);
+    QCOMPARE(mData.count(), oldCount);
+}
+
+void DataTest::setDeletedCount_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(COUNT);
+
+    QTest::newRow("Set deleted count should set the 0 deleted count to a new value") << Setup::Empty << int64_t(10);
+    QTest::newRow("Set deleted count should not change the count") << Setup::Data << int64_t(10);
+}
+
 void DataTest::setMetaData()
 {
     QFETCH(int64_t, index);
@@ -281,4 +329,25 @@ void DataTest::value_data()
     QTest::newRow("Value of default constructed data should have default value") << Setup::Empty << int64_t(1) << 0;
     QTest::newRow("Value of data with values should have correct value") << Setup::Data << int64_t(1) << 11;
 }
+
+void DataTest::valueData()
+{
+    QFETCH(int64_t, index);
+    QFETCH(int, value);
+
+    *mData.valueData(index) += value;
+
+    QTEST(mData.value(index), RESULT);
+}
+
+void DataTest::valueData_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<int>(VALUE);
+    QTest::addColumn<int>(RESULT);
+
+    QTest::newRow("Value modified in default constructed data should be stored") << Setup::Empty << int64_t(1) << -100 << -100;
+    QTest::newRow("Value modified in data with values should be stored") << Setup::Data << int64_t(1) << -100 << -89;
+}
 }
@@ -35,10 +35,14 @@ private slots:
     void count_data();
     void dataSize();
     void dataSize_data();
+    void deletedCount();
+    void deletedCount_data();
     void key();
     void key_data();
     void metaData();
     void metaData_data();
+    void metaDataAlignment();
+    void metaDataAlignment_data();
     void metaSize();
     void metaSize_data();
     void resize();
@@ -47,6 +51,8 @@ private slots:
     void setCount_data();
     void setData();
     void setData_data();
+    void setDeletedCount();
+    void setDeletedCount_data();
     void setMetaData();
     void setMetaData_data();
     void setMetaValue();
@@ -55,6 +61,8 @@ private slots:
     void setValue_data();
     void value();
     void value_data();
+    void valueData();
+    void valueData_data();
 
 private:
     Data<int, int> mData = Data<int, int>(0, 0, 0);
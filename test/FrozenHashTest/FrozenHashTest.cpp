@@ -0,0 +1,238 @@
+#include "FrozenHashTest.h"
+
+#include <QTest>
+#include <TestExtras.h>
+
+QTEST_APPLESS_MAIN(adb::FrozenHashTest)
+
+namespace adb
+{
+namespace
+{
+qint64 compareCount = 0;
+
+struct CountedKey
+{
+    bool operator==(const CountedKey &other) const
+    {
+        compareCount++;
+        return value == other.value;
+    }
+
+    qint64 value = 0;
+};
+
+struct CountedKeyHash
+{
+    uint64_t operator()(const CountedKey &key) const
+    {
+        return IntegerHash<qint64>(key.value);
+    }
+};
+}
+
+void FrozenHashTest::init()
+{
+    QFETCH(qint64, count);
+
+    mHash = decltype(mHash)();
+
+    for(qint64 key = 0; key < count; key++)
+        mHash.insert(key, key * 10);
+
+    for(qint64 key = 0; key < count; key += 10)
+        mHash.insert(key, key * 10 + 1);
+
+    mFrozen = mHash.freeze();
+}
+
+void FrozenHashTest::compares()
+{
+    QFETCH(qint64, count);
+
+    std::vector<std::pair<CountedKey, qint64>> data;
+
+    for(qint64 key = 0; key < count; key++)
+        data.push_back({CountedKey{key}, key});
+
+    const FrozenHash<CountedKey, qint64, CountedKeyHash> frozen(std::move(data), CountedKeyHash());
+    compareCount = 0;
+
+    for(qint64 key = 0; key < count; key++)
+        QCOMPARE(frozen.value(CountedKey{key}, -1), key);
+
+    QVERIFY(compareCount < count + count / 4);
+}
+
+void FrozenHashTest::compares_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Keys sharing a power of two number of homes should rarely share tags") << qint64(1016);
+    QTest::newRow("Keys sharing an odd number of homes should rarely share tags") << qint64(1000);
+}
+
+void FrozenHashTest::contains()
+{
+    QFETCH(qint64, key);
+
+    QTEST(mFrozen.contains(key), RESULT);
+}
+
+void FrozenHashTest::contains_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Empty frozen hash should not contain any key") << qint64(0) << qint64(1) << false;
+    QTest::newRow("Frozen hash should contain frozen key") << qint64(1000) << qint64(999) << true;
+    QTest::newRow("Frozen hash should not contain missing key") << qint64(1000) << qint64(1000) << false;
+}
+
+void FrozenHashTest::contains_value()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+
+    QTEST(mFrozen.contains(key, value), RESULT);
+}
+
+void FrozenHashTest::contains_value_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Frozen hash should contain frozen key-value pair") << qint64(1000) << qint64(20) << qint64(201) << true;
+    QTest::newRow("Frozen hash should not contain key with different value") << qint64(1000) << qint64(21) << qint64(211) << false;
+}
+
+void FrozenHashTest::count()
+{
+    QCOMPARE(mFrozen.count(), mHash.count());
+    QCOMPARE(mFrozen.isEmpty(), mHash.isEmpty());
+}
+
+void FrozenHashTest::count_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Empty frozen hash should be empty") << qint64(0);
+    QTest::newRow("Frozen hash should have same count as the hash") << qint64(1000);
+}
+
+void FrozenHashTest::count_key()
+{
+    QFETCH(qint64, key);
+
+    QTEST(mFrozen.count(key), RESULT);
+}
+
+void FrozenHashTest::count_key_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Key with multiple values should be counted for each value") << qint64(1000) << qint64(500) << qint64(2);
+    QTest::newRow("Key with single value should be counted once") << qint64(1000) << qint64(501) << qint64(1);
+    QTest::newRow("Missing key should not be counted") << qint64(1000) << qint64(-1) << qint64(0);
+}
+
+void FrozenHashTest::hashFunction()
+{
+    QFETCH(qint64, count);
+
+    ADbMap<qint64, qint64, SeededHash<qint64, IntegerHash<qint64>>> hash;
+
+    for(qint64 key = 0; key < count; key++)
+        hash.insert(key, -key);
+
+    const auto frozen = hash.freeze();
+
+    QCOMPARE(frozen.hashFunction().seed(), hash.hashFunction().seed());
+
+    for(qint64 key = 0; key < count; key++)
+        QCOMPARE(frozen.value(key), -key);
+}
+
+void FrozenHashTest::hashFunction_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Frozen hash should keep the hash function instance of the hash") << qint64(1000);
+}
+
+void FrozenHashTest::iterator()
+{
+    qint64 count = 0;
+
+    for(const std::pair<qint64, qint64> &keyValue : mFrozen)
+    {
+        QVERIFY(mHash.contains(keyValue.first, keyValue.second));
+        count++;
+    }
+
+    QCOMPARE(count, mHash.count());
+}
+
+void FrozenHashTest::iterator_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Iteration should visit every key-value pair of the hash") << qint64(1000);
+}
+
+void FrozenHashTest::memoryUsage()
+{
+    QVERIFY(mFrozen.memoryUsage() < mHash.memoryUsage());
+}
+
+void FrozenHashTest::memoryUsage_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Frozen hash should use less memory than the hash") << qint64(1000);
+    QTest::newRow("Frozen hash should use less memory than the hash with few elements") << qint64(10);
+}
+
+void FrozenHashTest::value()
+{
+    QFETCH(qint64, key);
+
+    QTEST(mFrozen.value(key, -1), VALUE);
+}
+
+void FrozenHashTest::value_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+
+    QTest::newRow("Value of frozen key should be returned") << qint64(1000) << qint64(7) << qint64(70);
+    QTest::newRow("Default value should be returned for missing key") << qint64(1000) << qint64(1001) << qint64(-1);
+}
+
+void FrozenHashTest::values()
+{
+    QFETCH(qint64, key);
+    QFETCH(QVector<qint64>, values);
+
+    std::vector<qint64> actualValues = mFrozen.values(key);
+    std::sort(actualValues.begin(), actualValues.end());
+
+    QCOMPARE(actualValues, values.toStdVector());
+}
+
+void FrozenHashTest::values_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<QVector<qint64>>(VALUES);
+
+    QTest::newRow("All values of the key should be returned") << qint64(1000) << qint64(30) << QVector<qint64>{300, 301};
+    QTest::newRow("No values should be returned for missing key") << qint64(1000) << qint64(-5) << QVector<qint64>();
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <ADbHash.h>
+#include <QObject>
+
+namespace adb
+{
+class FrozenHashTest : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+private slots:
+    void init();
+
+    void compares();
+    void compares_data();
+    void contains();
+    void contains_data();
+    void contains_value();
+    void contains_value_data();
+    void count();
+    void count_data();
+    void count_key();
+    void count_key_data();
+    void hashFunction();
+    void hashFunction_data();
+    void iterator();
+    void iterator_data();
+    void memoryUsage();
+    void memoryUsage_data();
+    void value();
+    void value_data();
+    void values();
+    void values_data();
+
+private:
+    ADbHash<qint64, qint64> mHash;
+    FrozenHash<qint64, qint64, IdentityHash<qint64>> mFrozen;
+};
+}
@@ -0,0 +1,230 @@
+#include "HashFunctionsTest.h"
+
+#include <HashFunctions.h>
+#include <QTest>
+#include <TestExtras.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+QTEST_APPLESS_MAIN(adb::HashFunctionsTest)
+
+namespace adb
+{
+double HashFunctionsTest::avalancheBias(int inputBits, int64_t samples, const std::function<uint64_t(const std::vector<char> &)> &hash)
+{
+    std::mt19937_64 generator(inputBits);
+    std::vector<int64_t> flips(static_cast<size_t>(inputBits) * 64);
+    std::vector<char> input(static_cast<size_t>((inputBits + 7) / 8));
+
+    for(int64_t sample = 0; sample < samples; sample++)
+    {
+        for(char &byte : input)
+            byte = static_cast<char>(generator());
+
+        const uint64_t original = hash(input);
+
+        for(int bit = 0; bit < inputBits; bit++)
+        {
+            input[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+            const uint64_t changed = original ^ hash(input);
+            input[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+
+            for(int outputBit = 0; outputBit < 64; outputBit++)
+                flips[bit * 64 + outputBit] += (changed >> outputBit) & 1;
+        }
+    }
+
+    double bias = 0;
+
+    for(int64_t count : flips)
+        bias = std::max(bias, std::abs(static_cast<double>(count) / samples - 0.5));
+
+    return bias;
+}
+
+double HashFunctionsTest::distribution(const std::vector<uint64_t> &hashes, uint64_t buckets, uint64_t shift)
+{
+    std::vector<int64_t> counts(buckets);
+
+    for(uint64_t hash : hashes)
+        counts[(hash >> shift) % buckets]++;
+
+    const double expected = static_cast<double>(hashes.size()) / buckets;
+    double chiSquare = 0;
+
+    for(int64_t count : counts)
+        chiSquare += (count - expected) * (count - expected) / expected;
+
+    return (chiSquare - (buckets - 1)) / std::sqrt(2.0 * (buckets - 1));
+}
+
+void HashFunctionsTest::integerAvalanche()
+{
+    QFETCH(qint64, count);
+
+    const double bias = avalancheBias(64, count, [](const std::vector<char> &input) {
+        int64_t value = 0;
+        std::memcpy(&value, input.data(), sizeof(value));
+        return static_cast<uint64_t>(IntegerHash<int64_t>(value));
+    });
+
+    QVERIFY(bias < 0.05);
+}
+
+void HashFunctionsTest::integerAvalanche_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Flipping any input bit should flip every output bit with probability close to 1/2") << qint64(5000);
+}
+
+void HashFunctionsTest::integerCollisions()
+{
+    QFETCH(qint64, count);
+
+    std::vector<uint64_t> hashes;
+
+    for(qint64 key = 1; key <= count; key++)
+    {
+        hashes.push_back(IntegerHash<int64_t>(key));
+        hashes.push_back(IntegerHash<int64_t>(key << 32));
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+
+    QVERIFY(std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end());
+}
+
+void HashFunctionsTest::integerCollisions_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Distinct integers should not collide") << qint64(100000);
+}
+
+void HashFunctionsTest::integerDistribution()
+{
+    QFETCH(qint64, count);
+    QFETCH(qint64, size);
+
+    std::vector<uint64_t> hashes;
+
+    for(qint64 key = 1; key <= count; key++)
+        hashes.push_back(IntegerHash<int64_t>(key * size));
+
+    QVERIFY(std::abs(distribution(hashes, 1024, 0)) < 6);
+    QVERIFY(std::abs(distribution(hashes, 128, 57)) < 6);
+}
+
+void HashFunctionsTest::integerDistribution_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(SIZE);
+
+    QTest::newRow("Sequential integers should be uniformly distributed") << qint64(100000) << qint64(1);
+    QTest::newRow("Integers with common stride should be uniformly distributed") << qint64(100000) << qint64(4096);
+    QTest::newRow("Integers differing only in high bits should be uniformly distributed") << qint64(100000) << (qint64(1) << 40);
+}
+
+void HashFunctionsTest::stringAvalanche()
+{
+    QFETCH(qint64, count);
+    QFETCH(qint64, size);
+
+    const double bias = avalancheBias(static_cast<int>(size * 8), count, [](const std::vector<char> &input) {
+        return static_cast<uint64_t>(StringHash(input.data(), static_cast<int64_t>(input.size())));
+    });
+
+    QVERIFY(bias < 0.1);
+}
+
+void HashFunctionsTest::stringAvalanche_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(SIZE);
+
+    QTest::newRow("2 byte keys should avalanche") << qint64(2000) << qint64(2);
+    QTest::newRow("3 byte keys should avalanche") << qint64(2000) << qint64(3);
+    QTest::newRow("4 byte keys should avalanche") << qint64(2000) << qint64(4);
+    QTest::newRow("8 byte keys should avalanche") << qint64(2000) << qint64(8);
+    QTest::newRow("16 byte keys should avalanche") << qint64(2000) << qint64(16);
+    QTest::newRow("17 byte keys should avalanche") << qint64(2000) << qint64(17);
+    QTest::newRow("49 byte keys should avalanche") << qint64(2000) << qint64(49);
+    QTest::newRow("100 byte keys should avalanche") << qint64(2000) << qint64(100);
+}
+
+void HashFunctionsTest::stringCollisions()
+{
+    QFETCH(qint64, count);
+
+    std::vector<uint64_t> hashes;
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        hashes.push_back(StringHash(std::to_string(key)));
+        hashes.push_back(StringHash(std::string(static_cast<size_t>(key % 200 + 1), '\0') + std::to_string(key / 200)));
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+
+    QVERIFY(std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end());
+}
+
+void HashFunctionsTest::stringCollisions_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Distinct strings including zero padded ones should not collide") << qint64(100000);
+}
+
+void HashFunctionsTest::stringDistribution()
+{
+    QFETCH(qint64, count);
+    QFETCH(qint64, size);
+
+    std::vector<uint64_t> hashes;
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        std::string value = std::to_string(key);
+        value.insert(0, static_cast<size_t>(std::max<qint64>(size - static_cast<qint64>(value.size()), 0)), '0');
+        hashes.push_back(StringHash(value));
+    }
+
+    QVERIFY(std::abs(distribution(hashes, 1024, 0)) < 6);
+    QVERIFY(std::abs(distribution(hashes, 128, 57)) < 6);
+}
+
+void HashFunctionsTest::stringDistribution_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(SIZE);
+
+    QTest::newRow("Short numeric strings should be uniformly distributed") << qint64(100000) << qint64(0);
+    QTest::newRow("Zero padded numeric strings should be uniformly distributed") << qint64(100000) << qint64(16);
+    QTest::newRow("Long zero padded numeric strings should be uniformly distributed") << qint64(100000) << qint64(64);
+}
+
+void HashFunctionsTest::stringSpan()
+{
+    QFETCH(QString, value);
+
+    const std::string string = value.toStdString();
+
+    QCOMPARE(static_cast<quint64>(StringHash(string)), static_cast<quint64>(StringHash(string.data(), static_cast<int64_t>(string.size()))));
+    QCOMPARE(static_cast<quint64>(StringHash(string)), static_cast<quint64>(StringHash(std::string(string))));
+    QVERIFY(static_cast<uint64_t>(StringHash(string)) != static_cast<uint64_t>(StringHash(string + '\0')));
+}
+
+void HashFunctionsTest::stringSpan_data()
+{
+    QTest::addColumn<QString>(VALUE);
+
+    QTest::newRow("Empty string should hash the same as empty byte span") << QString();
+    QTest::newRow("Short string should hash the same as its byte span") << QString("key");
+    QTest::newRow("Long string should hash the same as its byte span") << QString("a long key that spans more than forty eight bytes of data");
+}
+}
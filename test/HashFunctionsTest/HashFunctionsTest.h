@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QObject>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace adb
+{
+class HashFunctionsTest : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+    static double avalancheBias(int inputBits, int64_t samples, const std::function<uint64_t(const std::vector<char> &)> &hash);
+    static double distribution(const std::vector<uint64_t> &hashes, uint64_t buckets, uint64_t shift);
+
+private slots:
+    void integerAvalanche();
+    void integerAvalanche_data();
+    void integerCollisions();
+    void integerCollisions_data();
+    void integerDistribution();
+    void integerDistribution_data();
+    void stringAvalanche();
+    void stringAvalanche_data();
+    void stringCollisions();
+    void stringCollisions_data();
+    void stringDistribution();
+    void stringDistribution_data();
+    void stringSpan();
+    void stringSpan_data();
+};
+}
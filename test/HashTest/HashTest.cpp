@@ -2,12 +2,27 @@
 
 #include <QTest>
 #include <TestExtras.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
 
 Q_DECLARE_METATYPE(adb::HashTest::Setup)
 QTEST_APPLESS_MAIN(adb::HashTest)
 
 namespace adb
 {
+HashTest::FloodHash::FloodHash(qint64 value, uint64_t seed) :
+    mValue(seed == 0 ? 0 : static_cast<uint64_t>(IntegerHash<qint64>(value, seed)))
+{
+}
+
+HashTest::FloodHash::operator uint64_t() const
+{
+    return mValue;
+}
+
 const QVector<QPair<qint64, qint64>> SORTED_VALUES = HashTest::createValues();
 const QVector<QPair<qint64, qint64>> SORTED_REMOVED_VALUES = HashTest::createRemovedValues();
 const QVector<QPair<qint64, qint64>> SORTED_MULTI_VALUES = HashTest::createMultiHashValues();
@@ -43,6 +58,119 @@ void HashTest::init()
     }
 }
 
+void HashTest::aggregate()
+{
+    using ValuesList = QVector<QPair<qint64, qint64>>;
+
+    QFETCH(ValuesList, values);
+
+    ADbMap<qint64, qint64> map;
+    std::map<qint64, qint64> expected;
+    std::vector<qint64> keys;
+    std::vector<qint64> vals;
+
+    for(const QPair<qint64, qint64> &keyValue : values)
+    {
+        keys.push_back(keyValue.first);
+        vals.push_back(keyValue.second);
+        expected[keyValue.first] += keyValue.second;
+    }
+
+    map.aggregate(keys.begin(), keys.end(), vals.begin(), std::plus<qint64>());
+
+    QCOMPARE(map.count(), static_cast<qint64>(expected.size()));
+
+    for(const std::pair<const qint64, qint64> &keyValue : expected)
+        QCOMPARE(map.value(keyValue.first), keyValue.second);
+}
+
+void HashTest::aggregate_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<QVector<QPair<qint64, qint64>>>(VALUES);
+
+    QVector<QPair<qint64, qint64>> lowCardinality;
+    QVector<QPair<qint64, qint64>> highCardinality;
+
+    for(qint64 i = 0; i < 1000; i++)
+    {
+        lowCardinality.append({i % 7, i});
+        highCardinality.append({i * 13, i});
+    }
+
+    QTest::newRow("Aggregating nothing should leave the map empty") << Setup::None << QVector<QPair<qint64, qint64>>();
+    QTest::newRow("Aggregating distinct keys should insert all of them") << Setup::None << SORTED_VALUES;
+    QTest::newRow("Aggregating repeated keys should combine their values") << Setup::None << SORTED_MULTI_VALUES;
+    QTest::newRow("Aggregating values with the same hash should combine across full groups") << Setup::None << createSameHashValues() + createSameHashValues();
+    QTest::newRow("Aggregating few keys should combine most rows") << Setup::None << lowCardinality;
+    QTest::newRow("Aggregating many keys should grow the map between rows") << Setup::None << highCardinality;
+}
+
+void HashTest::aggregate_existing()
+{
+    QFETCH(qint64, value);
+
+    std::vector<qint64> keys;
+
+    for(const QPair<qint64, qint64> &keyValue : SORTED_VALUES)
+        keys.push_back(keyValue.first);
+
+    const std::vector<qint64> values(keys.size(), value);
+    mHash.aggregate(keys.begin(), keys.end(), values.begin(), [](qint64 current, qint64 other) { return std::max(current, other); });
+
+    for(const QPair<qint64, qint64> &keyValue : SORTED_VALUES)
+        QCOMPARE(mHash.value(keyValue.first), std::max(keyValue.second, value));
+
+    QCOMPARE(mHash.count(), static_cast<qint64>(SORTED_VALUES.count()));
+}
+
+void HashTest::aggregate_existing_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(VALUE);
+
+    QTest::newRow("Aggregating existing keys should keep larger stored values") << Setup::Data << qint64(5000);
+    QTest::newRow("Aggregating existing keys should replace smaller stored values") << Setup::Data << qint64(20000);
+}
+
+void HashTest::allocation()
+{
+    QFETCH(qint64, count);
+    QFETCH(qint64, result);
+
+    std::vector<qint64> keys{-1, -2, -3};
+    int64_t found = 0;
+
+    QVERIFY(!mHash.contains(1));
+    QCOMPARE(mHash.value(1, -1), qint64(-1));
+    QVERIFY(mHash.values(1).empty());
+    QCOMPARE(mHash.remove(1), qint64(0));
+    QCOMPARE(mHash.remove(keys), qint64(0));
+    mHash.find(keys.begin(), keys.end(), [&](qint64, ADbHash<qint64, qint64>::const_iterator it) { found += it != mHash.cend(); });
+
+    for(qint64 key = 0; key < count; key++)
+        mHash.insert(key + 1000, key);
+
+    QCOMPARE(found, int64_t(0));
+    QCOMPARE(mHash.stats().capacity, result);
+
+    mHash.clear();
+
+    QCOMPARE(mHash.stats().capacity, qint64(0));
+    QCOMPARE(mHash.memoryUsage(), static_cast<qint64>(sizeof(mHash)));
+}
+
+void HashTest::allocation_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Empty hash should not allocate") << Setup::None << qint64(0) << qint64(0);
+    QTest::newRow("First insertion should allocate a single group") << Setup::None << qint64(1) << qint64(16);
+    QTest::newRow("Hash with data should keep its allocation until cleared") << Setup::Removed << qint64(0) << qint64(128);
+}
+
 void HashTest::clear()
 {
     mHash.clear();
@@ -212,6 +340,163 @@ void HashTest::count_key_value_data()
     QTest::newRow("Hash with multi key data should should have count of the key-value 3") << Setup::Multi << qint64(12) << qint64(6) << qint64(3);
 }
 
+void HashTest::equal_range()
+{
+    QFETCH(qint64, key);
+    QFETCH(QVector<qint64>, values);
+
+    std::vector<qint64> actualValues;
+
+    for(auto range = qAsConst(mHash).equal_range(key); range.first != range.second; ++range.first)
+    {
+        QCOMPARE(range.first.key(), key);
+        actualValues.push_back(*range.first);
+    }
+
+    std::sort(actualValues.begin(), actualValues.end());
+    QCOMPARE(actualValues, values.toStdVector());
+
+    for(auto range = mHash.equal_range(key); range.first != range.second; ++range.first)
+        *range.first = qint64(-1);
+
+    QCOMPARE(mHash.count(key, qint64(-1)), qint64(values.count()));
+}
+
+void HashTest::equal_range_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<QVector<qint64>>(VALUES);
+
+    QTest::newRow("Empty hash should return empty range") << Setup::None << qint64(1) << QVector<qint64>();
+    QTest::newRow("Hash with data should return range of the key") << Setup::Data << qint64(12) << QVector<qint64>{2200};
+    QTest::newRow("Hash with removed data should return empty range for removed key") << Setup::Removed << qint64(1) << QVector<qint64>();
+    QTest::newRow("Hash with full group should return range of the key in overflown group") << Setup::FullGroup << qint64(33) << QVector<qint64>{34};
+    QTest::newRow("Hash with multi key data should return all values of the key") << Setup::Multi << qint64(100) << QVector<qint64>{33, 34, 34, 36, 37};
+}
+
+void HashTest::erase_if()
+{
+    QFETCH(qint64, value);
+
+    std::vector<std::pair<qint64, qint64>> expected;
+
+    for(auto it = mHash.begin(); it != mHash.end(); ++it)
+    {
+        if(it.key() % value != 0)
+            expected.emplace_back(it.key(), it.value());
+    }
+
+    const qint64 count = mHash.count();
+    QCOMPARE(mHash.erase_if([&](qint64 key, qint64) { return key % value == 0; }), count - static_cast<qint64>(expected.size()));
+    QCOMPARE(mHash.count(), static_cast<qint64>(expected.size()));
+
+    std::vector<std::pair<qint64, qint64>> actual;
+
+    for(auto it = mHash.begin(); it != mHash.end(); ++it)
+        actual.emplace_back(it.key(), it.value());
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    QVERIFY(actual == expected);
+
+    for(const std::pair<qint64, qint64> &keyValue : expected)
+        QVERIFY(mHash.contains(keyValue.first, keyValue.second));
+
+    for(qint64 key = 0; key < 200; key += value)
+        QVERIFY(!mHash.contains(key));
+}
+
+void HashTest::erase_if_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(VALUE);
+
+    QTest::newRow("Erasing from empty hash should do nothing") << Setup::None << qint64(2);
+    QTest::newRow("Erasing some keys should keep the others") << Setup::Data << qint64(3);
+    QTest::newRow("Erasing all keys should empty the hash") << Setup::Data << qint64(1);
+    QTest::newRow("Erasing from hash with removed data should keep the others") << Setup::Removed << qint64(2);
+    QTest::newRow("Erasing from full group should keep the others reachable") << Setup::FullGroup << qint64(3);
+    QTest::newRow("Erasing multi-valued keys should erase all their values") << Setup::Multi << qint64(8);
+}
+
+void HashTest::find_keys()
+{
+    QFETCH(QVector<qint64>, values);
+    QFETCH(qint64, count);
+
+    QVector<QPair<qint64, qint64>> expected;
+    QVector<QPair<qint64, qint64>> actual;
+
+    for(qint64 key : values)
+    {
+        const auto it = qAsConst(mHash).find(key);
+        expected.append({key, it == mHash.cend() ? qint64(-1) : *it});
+    }
+
+    mHash.find(values.begin(), values.end(), [&](qint64 key, auto it) { actual.append({key, it == mHash.cend() ? qint64(-1) : *it}); }, count);
+
+    QCOMPARE(actual, expected);
+}
+
+void HashTest::find_keys_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<QVector<qint64>>(VALUES);
+    QTest::addColumn<qint64>(COUNT);
+
+    QVector<qint64> keys;
+
+    for(qint64 key = -10; key < 110; key++)
+        keys.append(key);
+
+    QTest::newRow("Finding empty key range should report nothing") << Setup::Data << QVector<qint64>() << qint64(16);
+    QTest::newRow("Finding keys in empty hash should report every key as missing") << Setup::None << keys << qint64(16);
+    QTest::newRow("Finding keys should report each key in order") << Setup::Data << keys << qint64(16);
+    QTest::newRow("Finding keys one at a time should report each key in order") << Setup::Data << keys << qint64(1);
+    QTest::newRow("Finding keys deeper than their count should report each key in order") << Setup::Data << keys << qint64(1000);
+    QTest::newRow("Finding keys should report removed keys as missing") << Setup::Removed << keys << qint64(16);
+    QTest::newRow("Finding keys in multi hash should report the same element as find") << Setup::Multi << keys << qint64(16);
+}
+
+void HashTest::find_keys_plain()
+{
+    QFETCH(qint64, count);
+
+    Hash<qint64, qint64, PlainData, IntegerHash<qint64>> hash;
+    QVector<qint64> keys;
+    qint64 found = 0;
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        hash.insert(key, key * 2);
+        keys.append(key * 2);
+    }
+
+    hash.find(keys.begin(), keys.end(), [&](qint64 key, auto it) {
+        if(it != hash.cend())
+        {
+            QCOMPARE(*it, key * 2);
+            found++;
+        }
+    });
+
+    const bool plainPrefetch = HasPrefetch<PlainData>::value || HasPrefetchMetaData<PlainData>::value;
+    const bool dataPrefetch = HasPrefetch<Data<qint64, qint64>>::value && HasPrefetchMetaData<Data<qint64, qint64>>::value;
+
+    QVERIFY(!plainPrefetch);
+    QVERIFY(dataPrefetch);
+    QCOMPARE(found, (count + 1) / 2);
+}
+
+void HashTest::find_keys_plain_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Finding keys should work with storage that cannot prefetch") << Setup::None << qint64(100000);
+}
+
 void HashTest::insert()
 {
     using ValuesList = QVector<QPair<qint64, qint64>>;
@@ -239,6 +524,64 @@ void HashTest::insert_data()
     QTest::newRow("Inserting multiple values with the same key should insert them correctly") << Setup::Multi << QVector<QPair<qint64, qint64>>{{12, 20}, {12, 21}} << qint64(32);
 }
 
+void HashTest::insert_or_assign()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+    QFETCH(bool, result);
+
+    const qint64 count = mHash.count(key);
+    const auto inserted = mHash.insert_or_assign(key, value);
+
+    QCOMPARE(inserted.second, result);
+    QCOMPARE(*inserted.first, value);
+    QCOMPARE(inserted.first.key(), key);
+    QCOMPARE(mHash.count(key), result ? count + 1 : count);
+    QCOMPARE(mHash.count(key, value), qint64(1));
+}
+
+void HashTest::insert_or_assign_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Inserting or assigning into empty hash should insert new key-value pair") << Setup::None << qint64(1) << qint64(-1) << true;
+    QTest::newRow("Inserting or assigning existing key should assign the value") << Setup::Data << qint64(1) << qint64(-1) << false;
+    QTest::newRow("Inserting or assigning removed key should insert new key-value pair") << Setup::Removed << qint64(1) << qint64(-1) << true;
+    QTest::newRow("Inserting or assigning key in overflown group should assign the value") << Setup::FullGroup << qint64(33) << qint64(-1) << false;
+    QTest::newRow("Inserting or assigning multi-valued key should assign one of the values") << Setup::Multi << qint64(100) << qint64(-1) << false;
+}
+
+void HashTest::insert_unique()
+{
+    using ValuesList = QVector<QPair<qint64, qint64>>;
+
+    QFETCH(ValuesList, values);
+
+    ADbMap<qint64, qint64> map;
+
+    for(const QPair<qint64, qint64> &keyValue : values)
+    {
+        QCOMPARE(*map.insert(keyValue.first, keyValue.second), keyValue.second);
+        QCOMPARE(map.count(keyValue.first), qint64(1));
+    }
+
+    QTEST(map.count(), COUNT);
+}
+
+void HashTest::insert_unique_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<QVector<QPair<qint64, qint64>>>(VALUES);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Inserting distinct keys into unique map should add all of them") << Setup::None << SORTED_VALUES << qint64(100);
+    QTest::newRow("Inserting values with the same hash into unique map should add all of them") << Setup::None << createSameHashValuesAfterRehashing() << qint64(30);
+    QTest::newRow("Inserting the same keys into unique map should overwrite their values") << Setup::None << SORTED_MULTI_VALUES << qint64(23);
+}
+
 void HashTest::isEmpty()
 {
     QTEST(mHash.isEmpty(), RESULT);
@@ -323,102 +666,494 @@ void HashTest::iterator_data()
     QTest::newRow("Hash with some data removed should iterate over existing values") << Setup::Removed << SORTED_REMOVED_VALUES;
 }
 
-void HashTest::operatorSquareBrackets()
+void HashTest::join()
 {
-    QFETCH(qint64, key);
-    QFETCH(qint64, value);
+    using ValuesList = QVector<QPair<qint64, qint64>>;
 
-    mHash[key] = value;
+    QFETCH(ValuesList, values);
+    QFETCH(qint64, count);
 
-    QCOMPARE(qAsConst(mHash)[key], value);
-}
+    ADbHash<qint64, qint64> other;
+    std::vector<std::tuple<qint64, qint64, qint64>> expected;
+    std::vector<std::tuple<qint64, qint64, qint64>> actual;
 
-void HashTest::operatorSquareBrackets_data()
-{
-    QTest::addColumn<Setup>(SETUP);
-    QTest::addColumn<qint64>(KEY);
-    QTest::addColumn<qint64>(VALUE);
+    for(const QPair<qint64, qint64> &keyValue : values)
+    {
+        other.insert(keyValue.first, keyValue.second);
 
-    QTest::newRow("Operator[] should insert new key for non existing key") << Setup::None << qint64(10) << qint64(-10);
-    QTest::newRow("Operator[] should overwrite value in the hash with data") << Setup::Data << qint64(10) << qint64(-10);
-    QTest::newRow("Operator[] should overwrite value in the hash with some data removed") << Setup::Data << qint64(10) << qint64(-10);
-    QTest::newRow("Operator[] should access one of the values associated with a key") << Setup::Multi << qint64(12) << qint64(6);
-}
+        for(qint64 value : mHash.values(keyValue.first))
+            expected.emplace_back(keyValue.first, keyValue.second, value);
+    }
 
-void HashTest::replace()
-{
-    QFETCH(qint64, key);
-    QFETCH(qint64, value);
-    QFETCH(qint64, count);
+    for(qint64 part = 0; part < count; part++)
+        mHash.join(other, [&](qint64 key, qint64 otherValue, qint64 value) { actual.emplace_back(key, otherValue, value); }, part, count);
 
-    QCOMPARE(mHash.replace(key, value), count);
-    QCOMPARE(mHash.value(key), value);
-    QCOMPARE(mHash.count(key, value), count);
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    QVERIFY(actual == expected);
 }
 
-void HashTest::replace_data()
+void HashTest::join_data()
 {
     QTest::addColumn<Setup>(SETUP);
-    QTest::addColumn<qint64>(KEY);
-    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<QVector<QPair<qint64, qint64>>>(VALUES);
     QTest::addColumn<qint64>(COUNT);
 
-    QTest::newRow("Replacing existing key should overwrite the value") << Setup::Data << qint64(1) << qint64(200000) << qint64(1);
-    QTest::newRow("Replacing existing key of multi-valued key should overwrite all values") << Setup::Multi << qint64(12) << qint64(200000) << qint64(3);
+    QTest::newRow("Joining with empty hash should yield nothing") << Setup::Data << QVector<QPair<qint64, qint64>>() << qint64(1);
+    QTest::newRow("Joining empty hash should yield nothing") << Setup::None << SORTED_VALUES << qint64(1);
+    QTest::newRow("Joining hash with itself should match every key") << Setup::Data << SORTED_VALUES << qint64(1);
+    QTest::newRow("Joining hash with removed data should skip removed keys") << Setup::Removed << SORTED_VALUES << qint64(1);
+    QTest::newRow("Joining multi hash should yield every pair of values") << Setup::Multi << SORTED_MULTI_VALUES << qint64(1);
+    QTest::newRow("Joining values with the same hash should match across full groups") << Setup::FullGroup << createSameHashValues() << qint64(1);
+    QTest::newRow("Joining in parts should yield every match exactly once") << Setup::Data << SORTED_VALUES << qint64(3);
+    QTest::newRow("Joining multi hash in parts should yield every match exactly once") << Setup::Multi << SORTED_MULTI_VALUES << qint64(7);
 }
 
-void HashTest::replace_old_value()
+void HashTest::join_keys()
 {
-    QFETCH(qint64, key);
-    QFETCH(qint64, oldValue);
-    QFETCH(qint64, value);
-    QFETCH(qint64, count);
+    QFETCH(QVector<qint64>, values);
 
-    QCOMPARE(mHash.replace(key, oldValue, value), count);
-    QCOMPARE(mHash.count(key, oldValue), 0);
-    QCOMPARE(mHash.count(key, value), count);
+    std::vector<std::pair<qint64, qint64>> expected;
+    std::vector<std::pair<qint64, qint64>> actual;
+
+    for(qint64 key : values)
+    {
+        for(qint64 value : mHash.values(key))
+            expected.emplace_back(key, value);
+    }
+
+    mHash.join(values.begin(), values.end(), [&](qint64 key, qint64 value) { actual.emplace_back(key, value); });
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    QVERIFY(actual == expected);
 }
 
-void HashTest::replace_old_value_data()
+void HashTest::join_keys_data()
 {
     QTest::addColumn<Setup>(SETUP);
-    QTest::addColumn<qint64>(KEY);
-    QTest::addColumn<qint64>(OLD_VALUE);
-    QTest::addColumn<qint64>(VALUE);
-    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<QVector<qint64>>(VALUES);
 
-    QTest::newRow("Replacing existing key-value pair of multi-valued key should overwrite all value correctly") << Setup::Multi << qint64(12) << qint64(6) << qint64(200000) << qint64(3);
+    QVector<qint64> keys;
+
+    for(qint64 key = -10; key < 110; key++)
+        keys.append(key);
+
+    QTest::newRow("Joining empty key range should yield nothing") << Setup::Data << QVector<qint64>();
+    QTest::newRow("Joining keys against empty hash should yield nothing") << Setup::None << keys;
+    QTest::newRow("Joining keys should yield only existing keys") << Setup::Data << keys;
+    QTest::newRow("Joining keys should skip removed keys") << Setup::Removed << keys;
+    QTest::newRow("Joining keys against multi hash should yield every value") << Setup::Multi << keys;
 }
 
-void HashTest::remove()
+void HashTest::memoryUsage()
 {
-    QFETCH(qint64, key);
     QFETCH(qint64, count);
 
-    for(qint64 i = 0; i < count; i++, key++)
-    {
-        qint64 count = mHash.count(key);
-        QCOMPARE(mHash.remove(key), count);
-        QCOMPARE(mHash.contains(key), false);
-    }
+    const qint64 usage = mHash.memoryUsage();
 
-    QTEST(mHash.count(), RESULT);
+    for(qint64 key = 0; key < count; key++)
+        mHash.insert(key + 1000, key);
+
+    QVERIFY(usage >= static_cast<qint64>(sizeof(mHash)));
+    QVERIFY(mHash.memoryUsage() > usage);
 }
 
-void HashTest::remove_data()
+void HashTest::memoryUsage_data()
 {
     QTest::addColumn<Setup>(SETUP);
-    QTest::addColumn<qint64>(KEY);
     QTest::addColumn<qint64>(COUNT);
-    QTest::addColumn<qint64>(RESULT);
 
-    QTest::newRow("Removing from empty hash should do nothing") << Setup::None << qint64(1) << qint64(1) << qint64(0);
-    QTest::newRow("Removing from hash with data should erase the keys") << Setup::Data << qint64(1) << qint64(1) << qint64(99);
-    QTest::newRow("Removing from hash with some data removed should erase the keys") << Setup::Removed << qint64(2) << qint64(1) << qint64(66);
-    QTest::newRow("Removing removed key should do nothing") << Setup::Removed << qint64(1) << qint64(1) << qint64(67);
-    QTest::newRow("Removing all keys should rehash the table multiple times") << Setup::Data << qint64(0) << qint64(100) << qint64(0);
-    QTest::newRow("Removing all keys from hash with full group should rehash the table") << Setup::FullGroup << qint64(0) << qint64(34) << qint64(0);
-    QTest::newRow("Removing a multi-value key from hash should remove all its occurances") << Setup::Multi << qint64(12) << qint64(1) << qint64(27);
+    QTest::newRow("Memory usage of empty hash should grow with inserted data") << Setup::None << qint64(100);
+    QTest::newRow("Memory usage of hash with data should grow with inserted data") << Setup::Data << qint64(100);
+}
+
+void HashTest::merge()
+{
+    using ValuesList = QVector<QPair<qint64, qint64>>;
+
+    QFETCH(ValuesList, values);
+
+    const qint64 count = mHash.count();
+    ADbHash<qint64, qint64> other;
+
+    for(const QPair<qint64, qint64> &keyValue : values)
+        other.insert(keyValue.first, keyValue.second);
+
+    mHash.merge(other);
+
+    QCOMPARE(mHash.count(), count + values.count());
+    QCOMPARE(other.count(), static_cast<qint64>(values.count()));
+
+    for(const QPair<qint64, qint64> &keyValue : values)
+        QVERIFY(mHash.contains(keyValue.first, keyValue.second));
+
+    mHash.merge(std::move(other));
+
+    QCOMPARE(mHash.count(), count + values.count() * 2);
+    QVERIFY(other.isEmpty());
+}
+
+void HashTest::merge_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<QVector<QPair<qint64, qint64>>>(VALUES);
+
+    QTest::newRow("Merging into empty hash should copy all elements") << Setup::None << SORTED_VALUES;
+    QTest::newRow("Merging into hash with data should add all elements") << Setup::Data << SORTED_MULTI_VALUES;
+    QTest::newRow("Merging into hash with removed data should add all elements") << Setup::Removed << SORTED_VALUES;
+    QTest::newRow("Merging values with the same hash should add all elements") << Setup::FullGroup << createSameHashValues();
+}
+
+void HashTest::merge_self()
+{
+    QFETCH(qint64, count);
+
+    mHash.merge(mHash);
+
+    QCOMPARE(mHash.count(), count);
+
+    for(const QPair<qint64, qint64> &keyValue : SORTED_VALUES)
+        QCOMPARE(mHash.count(keyValue.first, keyValue.second), qint64(2));
+}
+
+void HashTest::merge_self_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Merging hash into itself should duplicate all elements") << Setup::Data << qint64(200);
+}
+
+void HashTest::merge_unique()
+{
+    using ValuesList = QVector<QPair<qint64, qint64>>;
+
+    QFETCH(ValuesList, values);
+
+    ADbMap<qint64, qint64> map;
+    ADbMap<qint64, qint64> other;
+    std::map<qint64, qint64> expected;
+
+    for(const QPair<qint64, qint64> &keyValue : SORTED_VALUES)
+    {
+        map.insert(keyValue.first, keyValue.second);
+        expected[keyValue.first] = keyValue.second;
+    }
+
+    for(const QPair<qint64, qint64> &keyValue : values)
+    {
+        other.insert(keyValue.first, keyValue.second);
+        expected[keyValue.first] = keyValue.second;
+    }
+
+    map.merge(other);
+
+    QCOMPARE(map.count(), static_cast<qint64>(expected.size()));
+
+    for(const std::pair<const qint64, qint64> &keyValue : expected)
+        QCOMPARE(map.value(keyValue.first), keyValue.second);
+}
+
+void HashTest::merge_unique_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<QVector<QPair<qint64, qint64>>>(VALUES);
+
+    QTest::newRow("Merging unique maps should overwrite values of existing keys") << Setup::None << SORTED_MULTI_VALUES;
+    QTest::newRow("Merging unique maps with distinct keys should add all of them") << Setup::None << createSameHashValuesAfterRehashing();
+}
+
+void HashTest::modify()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+    QFETCH(qint64, count);
+
+    std::vector<qint64> expected = mHash.values(key);
+
+    for(qint64 &expectedValue : expected)
+        expectedValue += value;
+
+    QCOMPARE(mHash.modify(key, [&](qint64 &val) { val += value; }), count);
+
+    std::vector<qint64> actual = mHash.values(key);
+    std::sort(actual.begin(), actual.end());
+    std::sort(expected.begin(), expected.end());
+
+    QVERIFY(actual == expected);
+}
+
+void HashTest::modify_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Modifying missing key should not modify anything") << Setup::None << qint64(1) << qint64(5) << qint64(0);
+    QTest::newRow("Modifying existing key should update the value in place") << Setup::Data << qint64(1) << qint64(5) << qint64(1);
+    QTest::newRow("Modifying multi-valued key should update all values") << Setup::Multi << qint64(12) << qint64(5) << qint64(3);
+}
+
+void HashTest::move()
+{
+    QFETCH(qint64, count);
+
+    ADbHash<qint64, qint64> hash(std::move(mHash));
+
+    QCOMPARE(hash.count(), count);
+    QVERIFY(mHash.isEmpty());
+
+    mHash.insert(1, 2);
+    QCOMPARE(mHash.value(1), qint64(2));
+
+    mHash = std::move(hash);
+
+    QCOMPARE(mHash.count(), count);
+    QVERIFY(hash.isEmpty());
+
+    for(const QPair<qint64, qint64> &keyValue : SORTED_VALUES)
+        QCOMPARE(mHash.value(keyValue.first), keyValue.second);
+}
+
+void HashTest::move_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Moved hash should keep all elements and leave the source empty") << Setup::Data << qint64(100);
+}
+
+void HashTest::operatorSquareBrackets()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+
+    mHash[key] = value;
+
+    QCOMPARE(qAsConst(mHash)[key], value);
+}
+
+void HashTest::operatorSquareBrackets_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+
+    QTest::newRow("Operator[] should insert new key for non existing key") << Setup::None << qint64(10) << qint64(-10);
+    QTest::newRow("Operator[] should overwrite value in the hash with data") << Setup::Data << qint64(10) << qint64(-10);
+    QTest::newRow("Operator[] should overwrite value in the hash with some data removed") << Setup::Data << qint64(10) << qint64(-10);
+    QTest::newRow("Operator[] should access one of the values associated with a key") << Setup::Multi << qint64(12) << qint64(6);
+}
+
+void HashTest::probePolicy()
+{
+    QFETCH(qint64, count);
+
+    Hash<qint64, qint64, Data<qint64, qint64>, IdentityHash<qint64>, MultiKey, TriangularProbe> triangular;
+    Hash<qint64, qint64, Data<qint64, qint64>, IdentityHash<qint64>, MultiKey, DoubleHashProbe> doubleHash;
+
+    for(auto it = mHash.begin(); it != mHash.end(); ++it)
+    {
+        triangular.insert(it.key(), it.value());
+        doubleHash.insert(it.key(), it.value());
+    }
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        mHash.insert(key * 3, key);
+        triangular.insert(key * 3, key);
+        doubleHash.insert(key * 3, key);
+
+        if(key % 4 == 0)
+        {
+            mHash.remove(key * 2);
+            triangular.remove(key * 2);
+            doubleHash.remove(key * 2);
+        }
+    }
+
+    QCOMPARE(triangular.count(), mHash.count());
+    QCOMPARE(doubleHash.count(), mHash.count());
+
+    for(qint64 key = -100; key < count * 3; key++)
+    {
+        std::vector<qint64> expectedValues = mHash.values(key);
+        std::vector<qint64> triangularValues = triangular.values(key);
+        std::vector<qint64> doubleHashValues = doubleHash.values(key);
+        std::sort(expectedValues.begin(), expectedValues.end());
+        std::sort(triangularValues.begin(), triangularValues.end());
+        std::sort(doubleHashValues.begin(), doubleHashValues.end());
+
+        QVERIFY(triangularValues == expectedValues);
+        QVERIFY(doubleHashValues == expectedValues);
+    }
+}
+
+void HashTest::probePolicy_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Triangular and double hash probing should find the same elements as linear probing") << Setup::None << qint64(10000);
+    QTest::newRow("Triangular and double hash probing should find the same elements as linear probing in hash with data") << Setup::Data << qint64(10000);
+    QTest::newRow("Triangular and double hash probing should find the same elements as linear probing in hash with multiple values") << Setup::Multi << qint64(1000);
+}
+
+void HashTest::replace()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+    QFETCH(qint64, count);
+
+    QCOMPARE(mHash.replace(key, value), count);
+    QCOMPARE(mHash.value(key), value);
+    QCOMPARE(mHash.count(key, value), count);
+}
+
+void HashTest::replace_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Replacing existing key should overwrite the value") << Setup::Data << qint64(1) << qint64(200000) << qint64(1);
+    QTest::newRow("Replacing existing key of multi-valued key should overwrite all values") << Setup::Multi << qint64(12) << qint64(200000) << qint64(3);
+}
+
+void HashTest::replace_old_value()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, oldValue);
+    QFETCH(qint64, value);
+    QFETCH(qint64, count);
+
+    QCOMPARE(mHash.replace(key, oldValue, value), count);
+    QCOMPARE(mHash.count(key, oldValue), 0);
+    QCOMPARE(mHash.count(key, value), count);
+}
+
+void HashTest::replace_old_value_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(OLD_VALUE);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Replacing existing key-value pair of multi-valued key should overwrite all value correctly") << Setup::Multi << qint64(12) << qint64(6) << qint64(200000) << qint64(3);
+}
+
+void HashTest::reseed()
+{
+    QFETCH(qint64, count);
+    QFETCH(bool, result);
+
+    ADbHash<qint64, qint64, SeededHash<qint64, FloodHash>> hash;
+    hash.setHashFunction(SeededHash<qint64, FloodHash>(0));
+
+    for(qint64 key = 0; key < count; key++)
+        hash.insert(key, key);
+
+    QCOMPARE(hash.hashFunction().seed() != 0, result);
+    QCOMPARE(hash.count(), count);
+
+    for(qint64 key = 0; key < count; key++)
+        QCOMPARE(hash.value(key), key);
+}
+
+void HashTest::reseed_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Few colliding keys should not reseed the hash function") << Setup::None << qint64(100) << false;
+    QTest::newRow("Flooding single probe sequence should reseed the hash function") << Setup::None << qint64(10000) << true;
+}
+
+void HashTest::remove()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, count);
+
+    for(qint64 i = 0; i < count; i++, key++)
+    {
+        qint64 count = mHash.count(key);
+        QCOMPARE(mHash.remove(key), count);
+        QCOMPARE(mHash.contains(key), false);
+    }
+
+    QTEST(mHash.count(), RESULT);
+}
+
+void HashTest::remove_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Removing from empty hash should do nothing") << Setup::None << qint64(1) << qint64(1) << qint64(0);
+    QTest::newRow("Removing from hash with data should erase the keys") << Setup::Data << qint64(1) << qint64(1) << qint64(99);
+    QTest::newRow("Removing from hash with some data removed should erase the keys") << Setup::Removed << qint64(2) << qint64(1) << qint64(66);
+    QTest::newRow("Removing removed key should do nothing") << Setup::Removed << qint64(1) << qint64(1) << qint64(67);
+    QTest::newRow("Removing all keys should rehash the table multiple times") << Setup::Data << qint64(0) << qint64(100) << qint64(0);
+    QTest::newRow("Removing all keys from hash with full group should rehash the table") << Setup::FullGroup << qint64(0) << qint64(34) << qint64(0);
+    QTest::newRow("Removing a multi-value key from hash should remove all its occurances") << Setup::Multi << qint64(12) << qint64(1) << qint64(27);
+}
+
+void HashTest::remove_keys()
+{
+    QFETCH(QVector<qint64>, values);
+
+    std::vector<qint64> keys(values.begin(), values.end());
+    qint64 removed = 0;
+    std::vector<std::pair<qint64, qint64>> expected;
+
+    for(auto it = mHash.begin(); it != mHash.end(); ++it)
+    {
+        if(std::find(keys.begin(), keys.end(), it.key()) == keys.end())
+            expected.emplace_back(it.key(), it.value());
+        else
+            removed++;
+    }
+
+    QCOMPARE(mHash.remove(keys), removed);
+    QCOMPARE(mHash.count(), static_cast<qint64>(expected.size()));
+
+    for(qint64 key : keys)
+        QVERIFY(!mHash.contains(key));
+
+    for(const std::pair<qint64, qint64> &keyValue : expected)
+        QVERIFY(mHash.contains(keyValue.first, keyValue.second));
+}
+
+void HashTest::remove_keys_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<QVector<qint64>>(VALUES);
+
+    QVector<qint64> all;
+    QVector<qint64> most;
+
+    for(qint64 key = 0; key < 100; key++)
+    {
+        all.append(key);
+
+        if(key % 5 != 0)
+            most.append(key);
+    }
+
+    QTest::newRow("Removing no keys should do nothing") << Setup::Data << QVector<qint64>();
+    QTest::newRow("Removing keys from empty hash should do nothing") << Setup::None << all;
+    QTest::newRow("Removing most keys should keep the others") << Setup::Data << most;
+    QTest::newRow("Removing all keys should empty the hash") << Setup::Data << all;
+    QTest::newRow("Removing duplicate and missing keys should remove each key once") << Setup::Removed << QVector<qint64>{1, 2, 2, 3, 1000, 3};
+    QTest::newRow("Removing keys from full group should keep the others reachable") << Setup::FullGroup << QVector<qint64>{1, 5, 9, 13, 17, 21, 25};
+    QTest::newRow("Removing multi-valued keys should remove all their values") << Setup::Multi << QVector<qint64>{12, 24, 4};
 }
 
 void HashTest::remove_value()
@@ -444,6 +1179,338 @@ void HashTest::remove_value_data()
     QTest::newRow("Remove key-value pair od multi-valued key should remove all instances") << Setup::Multi << qint64(12) << qint64(6);
 }
 
+void HashTest::remove_reinsert()
+{
+    QFETCH(qint64, count);
+
+    const qint64 size = mHash.count();
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        QCOMPARE(mHash.remove(key), qint64(1));
+        mHash.insert(key + size, key);
+    }
+
+    QTEST(mHash.count(), RESULT);
+
+    for(qint64 key = count; key < count + size; key++)
+        QVERIFY(mHash.contains(key));
+
+    QVERIFY(!mHash.contains(count + size));
+}
+
+void HashTest::remove_reinsert_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Repeatedly removing and inserting keys should keep the table consistent") << Setup::Data << qint64(10000) << qint64(100);
+}
+
+void HashTest::setFilter()
+{
+    QFETCH(qint64, count);
+
+    ADbHash<qint64, qint64> expected = mHash;
+
+    mHash.setFilter(BloomFilter(10));
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        mHash.insert(key * 7, key);
+        expected.insert(key * 7, key);
+
+        if(key % 3 == 0)
+        {
+            mHash.remove(key * 7 - 21);
+            expected.remove(key * 7 - 21);
+        }
+    }
+
+    QCOMPARE(mHash.filter().bitsPerElement(), qint64(10));
+    QCOMPARE(mHash.count(), expected.count());
+
+    for(qint64 key = -100; key < count * 7; key++)
+    {
+        std::vector<qint64> actualValues = mHash.values(key);
+        std::vector<qint64> expectedValues = expected.values(key);
+        std::sort(actualValues.begin(), actualValues.end());
+        std::sort(expectedValues.begin(), expectedValues.end());
+
+        QCOMPARE(mHash.contains(key), expected.contains(key));
+        QCOMPARE(mHash.value(key, -1), expected.value(key, -1));
+        QVERIFY(actualValues == expectedValues);
+    }
+}
+
+void HashTest::setFilter_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Filtered empty hash should find the same elements as unfiltered hash") << Setup::None << qint64(1000);
+    QTest::newRow("Filtered hash with data should find the same elements as unfiltered hash") << Setup::Data << qint64(1000);
+    QTest::newRow("Filtered hash with removed data should find the same elements as unfiltered hash") << Setup::Removed << qint64(1000);
+    QTest::newRow("Filtered multi hash should find the same elements as unfiltered hash") << Setup::Multi << qint64(1000);
+}
+
+void HashTest::setHashFunction()
+{
+    QFETCH(qint64, count);
+
+    ADbHash<qint64, qint64, SeededHash<qint64, IntegerHash<qint64>>> hash;
+
+    for(qint64 key = 0; key < count; key++)
+        hash.insert(key, key);
+
+    hash.setHashFunction(SeededHash<qint64, IntegerHash<qint64>>(count));
+
+    QCOMPARE(hash.hashFunction().seed(), static_cast<uint64_t>(count));
+    QCOMPARE(hash.count(), count);
+
+    for(qint64 key = 0; key < count; key++)
+        QCOMPARE(hash.value(key), key);
+}
+
+void HashTest::setHashFunction_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Replacing hash function should keep all elements accessible") << Setup::None << qint64(1000);
+}
+
+void HashTest::setLimit()
+{
+    QFETCH(qint64, count);
+    QFETCH(qint64, size);
+    QFETCH(qint64, result);
+
+    mHash.setLimit(size);
+
+    for(qint64 key = 1000; key < 1000 + count; key++)
+        mHash.insert(key, key * 2);
+
+    QCOMPARE(mHash.limit(), size);
+    QCOMPARE(mHash.count(), result);
+
+    qint64 iterated = 0;
+
+    for(auto it = mHash.begin(); it != mHash.end(); ++it)
+    {
+        if(it.key() >= 1000)
+            QCOMPARE(it.value(), it.key() * 2);
+
+        iterated++;
+    }
+
+    QCOMPARE(iterated, result);
+}
+
+void HashTest::setLimit_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(SIZE);
+    QTest::addColumn<qint64>(RESULT);
+
+    QTest::newRow("Unlimited hash should keep all elements") << Setup::None << qint64(1000) << qint64(0) << qint64(1000);
+    QTest::newRow("Limited hash should evict elements over the limit") << Setup::None << qint64(1000) << qint64(100) << qint64(100);
+    QTest::newRow("Limited hash below the limit should keep all elements") << Setup::None << qint64(100) << qint64(1000) << qint64(100);
+    QTest::newRow("Limiting hash with data should evict existing elements") << Setup::Data << qint64(0) << qint64(10) << qint64(10);
+    QTest::newRow("Limited multi hash should evict elements over the limit") << Setup::Multi << qint64(1000) << qint64(50) << qint64(50);
+}
+
+void HashTest::setLimit_referenced()
+{
+    QFETCH(qint64, count);
+    QFETCH(qint64, size);
+
+    ADbMap<qint64, qint64> map;
+    map.setLimit(size);
+
+    for(qint64 key = 0; key < size; key++)
+        map.insert(key, key);
+
+    for(qint64 key = 0; key < size - count; key++)
+        QCOMPARE(map.value(key), key);
+
+    for(qint64 key = size; key < size + count; key++)
+        map.insert(key, key);
+
+    QCOMPARE(map.count(), size);
+
+    for(qint64 key = 0; key < size - count; key++)
+        QCOMPARE(map.value(key, -1), key);
+}
+
+void HashTest::setLimit_referenced_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(SIZE);
+
+    QTest::newRow("Referenced elements should survive eviction") << Setup::None << qint64(50) << qint64(100);
+    QTest::newRow("Referenced elements should survive a scan of new elements") << Setup::None << qint64(10) << qint64(1000);
+}
+
+void HashTest::setWideTags()
+{
+    QFETCH(qint64, count);
+
+    const qint64 step = qint64(1) << 48;
+    ADbHash<qint64, qint64> expected = mHash;
+
+    mHash.setWideTags(true);
+
+    QVERIFY(mHash.wideTags());
+    QVERIFY(!expected.wideTags());
+    QCOMPARE(mHash.count(), expected.count());
+
+    for(qint64 key = 0; key < count; key++)
+    {
+        mHash.insert(key * step, key);
+        expected.insert(key * step, key);
+
+        if(key % 3 == 0)
+        {
+            mHash.remove((key - 3) * step);
+            expected.remove((key - 3) * step);
+        }
+    }
+
+    QCOMPARE(mHash.count(), expected.count());
+
+    for(qint64 key = -100; key < count; key++)
+    {
+        std::vector<qint64> actualValues = mHash.values(key * step);
+        std::vector<qint64> expectedValues = expected.values(key * step);
+        std::sort(actualValues.begin(), actualValues.end());
+        std::sort(expectedValues.begin(), expectedValues.end());
+
+        QCOMPARE(mHash.contains(key * step), expected.contains(key * step));
+        QVERIFY(actualValues == expectedValues);
+    }
+
+    mHash.setWideTags(false);
+
+    QVERIFY(!mHash.wideTags());
+
+    for(qint64 key = 0; key < count; key++)
+        QCOMPARE(mHash.contains(key * step), expected.contains(key * step));
+}
+
+void HashTest::setWideTags_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Hash with wide tags should find the same elements as hash without them") << Setup::None << qint64(1000);
+    QTest::newRow("Enabling wide tags in hash with data should keep all elements") << Setup::Data << qint64(1000);
+    QTest::newRow("Enabling wide tags in multi hash should keep all elements") << Setup::Multi << qint64(100);
+}
+
+void HashTest::stats()
+{
+    QFETCH(qint64, count);
+
+    mHash.contains(1);
+    const Statistics statistics = mHash.stats();
+
+    QCOMPARE(statistics.count, count);
+    QCOMPARE(statistics.deletedCount, qint64(0));
+    QVERIFY(statistics.capacity >= count);
+    QCOMPARE(statistics.loadFactor, statistics.capacity != 0 ? static_cast<double>(count) / statistics.capacity : 0.0);
+    QCOMPARE(statistics.lookups, qint64(0));
+}
+
+void HashTest::stats_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Statistics of empty hash should have no elements") << Setup::None << qint64(0);
+    QTest::newRow("Statistics should describe occupancy while counters stay compiled out") << Setup::Data << qint64(100);
+}
+
+void HashTest::swap()
+{
+    QFETCH(qint64, count);
+
+    ADbHash<qint64, qint64> other;
+    other.insert(-1, -2);
+
+    adb::swap(mHash, other);
+
+    QCOMPARE(mHash.count(), qint64(1));
+    QCOMPARE(mHash.value(-1), qint64(-2));
+    QCOMPARE(other.count(), count);
+
+    for(const QPair<qint64, qint64> &keyValue : SORTED_VALUES)
+        QCOMPARE(other.value(keyValue.first), keyValue.second);
+}
+
+void HashTest::swap_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Swapped hashes should exchange their elements") << Setup::Data << qint64(100);
+}
+
+void HashTest::try_emplace()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+    QFETCH(bool, result);
+
+    const qint64 oldValue = mHash.value(key, value);
+    const auto inserted = mHash.try_emplace(key, value);
+
+    QCOMPARE(inserted.second, result);
+    QCOMPARE(*inserted.first, result ? value : oldValue);
+    QCOMPARE(mHash.contains(key, value), result || oldValue == value);
+}
+
+void HashTest::try_emplace_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Emplacing into empty hash should insert new key-value pair") << Setup::None << qint64(1) << qint64(-1) << true;
+    QTest::newRow("Emplacing existing key should keep its value") << Setup::Data << qint64(1) << qint64(-1) << false;
+    QTest::newRow("Emplacing removed key should insert new key-value pair") << Setup::Removed << qint64(1) << qint64(-1) << true;
+    QTest::newRow("Emplacing key in overflown group should keep its value") << Setup::FullGroup << qint64(33) << qint64(-1) << false;
+}
+
+void HashTest::upsert()
+{
+    QFETCH(qint64, key);
+    QFETCH(qint64, value);
+    QFETCH(bool, result);
+
+    const qint64 oldValue = mHash.value(key, value);
+
+    QCOMPARE(mHash.upsert(key, value, [](qint64 &val) { val *= 2; }), result);
+    QCOMPARE(mHash.value(key), result ? value : oldValue * 2);
+}
+
+void HashTest::upsert_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<qint64>(VALUE);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Upserting into empty hash should insert new key-value pair") << Setup::None << qint64(1) << qint64(-1) << true;
+    QTest::newRow("Upserting existing key should modify its value") << Setup::Data << qint64(1) << qint64(-1) << false;
+    QTest::newRow("Upserting removed key should insert new key-value pair") << Setup::Removed << qint64(1) << qint64(-1) << true;
+    QTest::newRow("Upserting key in overflown group should modify its value") << Setup::FullGroup << qint64(33) << qint64(-1) << false;
+}
+
 void HashTest::value()
 {
     QFETCH(qint64, key);
@@ -20,6 +20,37 @@ public:
         Multi
     };
 
+    class FloodHash
+    {
+    public:
+        FloodHash(qint64 value, uint64_t seed);
+
+        operator uint64_t() const;
+
+    private:
+        uint64_t mValue = 0;
+    };
+
+    class PlainData : private Data<qint64, qint64>
+    {
+    public:
+        using Data::Data;
+        using Data::count;
+        using Data::dataSize;
+        using Data::deletedCount;
+        using Data::key;
+        using Data::metaData;
+        using Data::metaSize;
+        using Data::resize;
+        using Data::setCount;
+        using Data::setData;
+        using Data::setDeletedCount;
+        using Data::setMetaData;
+        using Data::setMetaValue;
+        using Data::setValue;
+        using Data::value;
+    };
+
     using QObject::QObject;
 
     static QVector<QPair<qint64, qint64>> createValues();
@@ -31,6 +62,12 @@ public:
 private slots:
     void init();
 
+    void aggregate();
+    void aggregate_data();
+    void aggregate_existing();
+    void aggregate_existing_data();
+    void allocation();
+    void allocation_data();
     void clear();
     void clear_data();
     void const_iterator();
@@ -45,22 +82,76 @@ private slots:
     void count_key_data();
     void count_key_value();
     void count_key_value_data();
+    void equal_range();
+    void equal_range_data();
+    void erase_if();
+    void erase_if_data();
+    void find_keys();
+    void find_keys_data();
+    void find_keys_plain();
+    void find_keys_plain_data();
     void insert();
     void insert_data();
+    void insert_or_assign();
+    void insert_or_assign_data();
+    void insert_unique();
+    void insert_unique_data();
     void isEmpty();
     void isEmpty_data();
     void iterator();
     void iterator_data();
+    void join();
+    void join_data();
+    void join_keys();
+    void join_keys_data();
+    void memoryUsage();
+    void memoryUsage_data();
+    void merge();
+    void merge_data();
+    void merge_self();
+    void merge_self_data();
+    void merge_unique();
+    void merge_unique_data();
+    void modify();
+    void modify_data();
+    void move();
+    void move_data();
     void operatorSquareBrackets();
     void operatorSquareBrackets_data();
+    void probePolicy();
+    void probePolicy_data();
     void replace();
     void replace_data();
+    void reseed();
+    void reseed_data();
     void replace_old_value();
     void replace_old_value_data();
     void remove();
     void remove_data();
+    void remove_keys();
+    void remove_keys_data();
     void remove_value();
     void remove_value_data();
+    void remove_reinsert();
+    void remove_reinsert_data();
+    void setFilter();
+    void setFilter_data();
+    void setHashFunction();
+    void setHashFunction_data();
+    void setLimit();
+    void setLimit_data();
+    void setLimit_referenced();
+    void setLimit_referenced_data();
+    void setWideTags();
+    void setWideTags_data();
+    void stats();
+    void stats_data();
+    void swap();
+    void swap_data();
+    void try_emplace();
+    void try_emplace_data();
+    void upsert();
+    void upsert_data();
     void value();
     void value_data();
     void values();
@@ -0,0 +1,450 @@
+#include "PagedDataTest.h"
+
+#include <Example.h>
+#include <HashFunctions.h>
+#include <QTest>
+#include <TestExtras.h>
+
+Q_DECLARE_METATYPE(adb::PagedDataTest::Setup)
+Q_DECLARE_METATYPE(adb::PagedDataTest::Node)
+QTEST_APPLESS_MAIN(adb::PagedDataTest)
+
+namespace adb
+{
+static constexpr int64_t DATA_SIZE = 96;
+static constexpr int64_t META_SIZE = DATA_SIZE + 16;
+static constexpr char META_VALUE = 1;
+static QVector<PagedDataTest::Node> DATA_VALUES = PagedDataTest::createValues();
+static QVector<char> META_VALUES = PagedDataTest::createMetaValues();
+
+constexpr int64_t PagedDataTest::PAGE_SIZE;
+constexpr int64_t PagedDataTest::CACHE_SIZE;
+constexpr const char *PagedDataTest::FILE_NAME;
+
+QVector<PagedDataTest::Node> PagedDataTest::createValues()
+{
+    QVector<Node> data;
+    data.reserve(DATA_SIZE);
+
+    for(int i = 0; i < DATA_SIZE; i++)
+        data.append(Node{i, i + 10});
+
+    return data;
+}
+
+QVector<char> PagedDataTest::createMetaValues()
+{
+    QVector<char> data;
+    data.reserve(META_SIZE);
+
+    for(int i = 0; i < META_SIZE; i++)
+        data.append(static_cast<char>(i));
+
+    return data;
+}
+
+void PagedDataTest::init()
+{
+    QFETCH(Setup, setup);
+
+    switch(setup)
+    {
+    case Setup::None:
+        mData = PagedData<int, int, PAGE_SIZE>(0, 0, 0, FILE_NAME, CACHE_SIZE);
+        break;
+    case Setup::Empty:
+        mData = PagedData<int, int, PAGE_SIZE>(DATA_SIZE, META_SIZE, META_VALUE, FILE_NAME, CACHE_SIZE);
+        break;
+    case Setup::Data:
+        mData = PagedData<int, int, PAGE_SIZE>(DATA_SIZE, META_SIZE, META_VALUE, FILE_NAME, CACHE_SIZE);
+        for(const Node &node : DATA_VALUES)
+            mData.setData(&node - DATA_VALUES.begin(), node.key, node.value);
+        mData.setMetaData(0, META_VALUES.toStdVector());
+        mData.setCount(DATA_SIZE);
+        break;
+    }
+}
+
+void PagedDataTest::cacheSize()
+{
+    QFETCH(int64_t, size);
+
+    const PagedData<int, int, PAGE_SIZE> data(DATA_SIZE, META_SIZE, META_VALUE, FILE_NAME, size);
+
+    QTEST(data.cacheSize(), RESULT);
+}
+
+void PagedDataTest::cacheSize_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(SIZE);
+    QTest::addColumn<int64_t>(RESULT);
+
+    QTest::newRow("Cache size should be the requested size in whole pages") << Setup::None << (CACHE_SIZE + 10) << CACHE_SIZE;
+    QTest::newRow("Cache size should be at least two pages") << Setup::None << int64_t(0) << (PAGE_SIZE * 2);
+}
+
+void PagedDataTest::count()
+{
+    QTEST(mData.count(), COUNT);
+}
+
+void PagedDataTest::count_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(COUNT);
+
+    QTest::newRow("Empty data shoul have 0 count") << Setup::Empty << int64_t(0);
+    QTest::newRow("Data with values should have correct count") << Setup::Data << DATA_SIZE;
+}
+
+void PagedDataTest::dataSize()
+{
+    QTEST(mData.dataSize(), SIZE);
+}
+
+void PagedDataTest::dataSize_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(SIZE);
+
+    QTest::newRow("Empty data should have dataSize 0") << Setup::None << int64_t(0);
+    QTest::newRow("Data with default values should have original construction size") << Setup::Empty << DATA_SIZE;
+    QTest::newRow("Data with values should have original construction size") << Setup::Data << DATA_SIZE;
+}
+
+void PagedDataTest::deletedCount()
+{
+    QTEST(mData.deletedCount(), COUNT);
+}
+
+void PagedDataTest::deletedCount_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(COUNT);
+
+    QTest::newRow("Empty data should have 0 deleted count") << Setup::Empty << int64_t(0);
+    QTest::newRow("Data with values should have 0 deleted count") << Setup::Data << int64_t(0);
+}
+
+void PagedDataTest::hash()
+{
+    QFETCH(int, count);
+
+    Hash<int, int, PagedData<int, int, PAGE_SIZE>, IntegerHash<int>> hash(FILE_NAME, CACHE_SIZE);
+
+    for(int key = 0; key < count; key++)
+        hash.insert(key, key * 2);
+
+    for(int key = 0; key < count; key += 3)
+        hash.remove(key);
+
+    for(int key = 1; key < count; key += 3)
+        hash.modify(key, [](int &value) { value++; });
+
+    const bool inPlace = HasValueData<PagedData<int, int, PAGE_SIZE>>::value;
+
+    QVERIFY(!inPlace);
+    QCOMPARE(hash.count(), static_cast<int64_t>(count - (count + 2) / 3));
+
+    for(int key = 0; key < count; key++)
+        QCOMPARE(hash.value(key, -1), key % 3 == 0 ? -1 : key * 2 + (key % 3 == 1));
+}
+
+void PagedDataTest::hash_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int>(COUNT);
+
+    QTest::newRow("Hash fitting in the cache stores its values in paged data") << Setup::None << 10;
+    QTest::newRow("Hash larger than the cache stores its values in paged data") << Setup::None << 10000;
+}
+
+void PagedDataTest::key()
+{
+    QFETCH(int64_t, index);
+
+    QTEST(mData.key(index), KEY);
+}
+
+void PagedDataTest::key_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<int>(KEY);
+
+    QTest::newRow("Key of default constructed data should have default value") << Setup::Empty << int64_t(1) << 0;
+    QTest::newRow("Key of data with values should have correct value") << Setup::Data << int64_t(1) << 1;
+}
+
+void PagedDataTest::memoryUsage()
+{
+    QFETCH(int64_t, size);
+
+    for(int64_t index = 0; index < mData.dataSize(); index++)
+        mData.key(index);
+
+    const int64_t usage = mData.memoryUsage();
+
+    QVERIFY(usage >= mData.cacheSize());
+
+    mData.resize(size, size + 16, META_VALUE);
+
+    for(int64_t index = 0; index < mData.dataSize(); index++)
+        mData.key(index);
+
+    QCOMPARE(mData.memoryUsage(), usage);
+}
+
+void PagedDataTest::memoryUsage_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(SIZE);
+
+    QTest::newRow("Memory usage of full cache should not grow with the file") << Setup::Empty << DATA_SIZE * 16;
+    QTest::newRow("Memory usage of data with values should not grow with the file") << Setup::Data << DATA_SIZE * 16;
+}
+
+void PagedDataTest::metaData()
+{
+    QFETCH(int64_t, index);
+    QFETCH(int64_t, size);
+
+    QTEST(QByteArray(mData.metaData(index, size), static_cast<int>(size)), VALUE);
+}
+
+void PagedDataTest::metaData_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<int64_t>(SIZE);
+    QTest::addColumn<QByteArray>(VALUE);
+
+    QTest::newRow("Meta values of default constructed data should have default values") << Setup::Empty << int64_t(16) << int64_t(16) << QByteArray(16, 1);
+    QTest::newRow("Meta values of data with values should have correct value") << Setup::Data << int64_t(16) << int64_t(16) << QByteArray::fromRawData(META_VALUES.data() + 16, 16);
+    QTest::newRow("Meta values within a page should be contiguous") << Setup::Data << int64_t(33) << int64_t(15) << QByteArray::fromRawData(META_VALUES.data() + 33, 15);
+}
+
+void PagedDataTest::metaDataAlignment()
+{
+    QCOMPARE(reinterpret_cast<uintptr_t>(mData.metaData(0, 16)) % 64, uintptr_t(0));
+    mData.resize(mData.dataSize() * 2 + 1, mData.metaSize() * 2 + 1, 1);
+    QCOMPARE(reinterpret_cast<uintptr_t>(mData.metaData(0, 16)) % 64, uintptr_t(0));
+}
+
+void PagedDataTest::metaDataAlignment_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+
+    QTest::newRow("Meta data of default constructed data should be aligned to 64 bytes") << Setup::Empty;
+    QTest::newRow("Meta data of data with values should be aligned to 64 bytes") << Setup::Data;
+}
+
+void PagedDataTest::metaSize()
+{
+    QTEST(mData.metaSize(), SIZE_META);
+}
+
+void PagedDataTest::metaSize_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(SIZE_META);
+
+    QTest::newRow("Empty data should have metaSize 0") << Setup::None << int64_t(0);
+    QTest::newRow("Data with default values should have original construction metaSize") << Setup::Empty << META_SIZE;
+    QTest::newRow("Data with values should have original construction metaSize") << Setup::Data << META_SIZE;
+}
+
+void PagedDataTest::move()
+{
+    PagedData<int, int, PAGE_SIZE> data(std::move(mData));
+
+    QCOMPARE(data.dataSize(), DATA_SIZE);
+    QCOMPARE(data.count(), DATA_SIZE);
+
+    for(const Node &node : DATA_VALUES)
+    {
+        QCOMPARE(data.key(&node - DATA_VALUES.begin()), node.key);
+        QCOMPARE(data.value(&node - DATA_VALUES.begin()), node.value);
+    }
+
+    QCOMPARE(mData.dataSize(), int64_t(0));
+    QCOMPARE(mData.count(), int64_t(0));
+
+    mData.resize(DATA_SIZE, META_SIZE, META_VALUE);
+    mData.setData(1, -10, -100);
+
+    QCOMPARE(QByteArray(mData.metaData(16, 16), 16), QByteArray(16, META_VALUE));
+    QCOMPARE(mData.value(1), -100);
+    QCOMPARE(data.value(1), 11);
+}
+
+void PagedDataTest::move_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+
+    QTest::newRow("Moved data should keep the values and leave the source empty but usable") << Setup::Data;
+}
+
+void PagedDataTest::resize()
+{
+    QFETCH(int64_t, size);
+    QFETCH(int64_t, sizeMeta);
+    QFETCH(char, value);
+
+    int64_t oldMetaSize = mData.metaSize();
+    mData.resize(size, sizeMeta, value);
+
+    QCOMPARE(mData.dataSize(), size);
+    QCOMPARE(mData.metaSize(), sizeMeta);
+    QCOMPARE(QByteArray(mData.metaData(oldMetaSize, 16), 16), QByteArray(16, value));
+}
+
+void PagedDataTest::resize_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(SIZE);
+    QTest::addColumn<int64_t>(SIZE_META);
+    QTest::addColumn<char>(VALUE);
+
+    QTest::newRow("Resizing zero sized data should add new default initialized data") << Setup::None << DATA_SIZE << META_SIZE << META_VALUE;
+    QTest::newRow("Resizing empty data should add new default initialized data") << Setup::Empty << (DATA_SIZE * 2) << (DATA_SIZE * 2 + 16) << META_VALUE;
+    QTest::newRow("Resizing data with values should add new default initialized data without changing existing data") << Setup::Data << (DATA_SIZE * 2) << (DATA_SIZE * 2 + 16) << META_VALUE;
+}
+
+void PagedDataTest::setCount()
+{
+    QFETCH(int64_t, count);
+
+    mData.setCount(count);
+    QCOMPARE(mData.count(), count);
+}
+
+void PagedDataTest::setCount_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(COUNT);
+
+    QTest::newRow("Set count should set the 0 count to a new value") << Setup::Empty << int64_t(10);
+    QTest::newRow("Set count should update the value to a new value") << Setup::Data << int64_t(10);
+}
+
+void PagedDataTest::setData()
+{
+    QFETCH(int64_t, index);
+    QFETCH(int, key);
+    QFETCH(int, value);
+
+    mData.setData(index, key, value);
+
+    QCOMPARE(mData.key(index), key);
+    QCOMPARE(mData.value(index), value);
+}
+
+void PagedDataTest::setData_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<int>(KEY);
+    QTest::addColumn<int>(VALUE);
+
+    QTest::newRow("Set value in default constructed data") << Setup::Empty << int64_t(1) << -10 << -100;
+    QTest::newRow("Set value in data with values overwrites the existing value") << Setup::Data << int64_t(1) << -10 << -100;
+}
+
+void PagedDataTest::setDeletedCount()
+{
+    QFETCH(int64_t, count);
+
+    const int64_t oldCount = mData.count();
+    mData.setDeletedCount(count);
+    QCOMPARE(mData.deletedCount(), count);
+    QCOMPARE(mData.count(), oldCount);
+}
+
+void PagedDataTest::setDeletedCount_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(COUNT);
+
+    QTest::newRow("Set deleted count should set the 0 deleted count to a new value") << Setup::Empty << int64_t(10);
+    QTest::newRow("Set deleted count should not change the count") << Setup::Data << int64_t(10);
+}
+
+void PagedDataTest::setMetaData()
+{
+    QFETCH(int64_t, index);
+    QFETCH(QVector<char>, values);
+
+    mData.setMetaData(index, values.toStdVector());
+
+    QCOMPARE(QByteArray(mData.metaData(index, values.count()), values.count()), QByteArray(values.data(), values.count()));
+}
+
+void PagedDataTest::setMetaData_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<QVector<char>>(VALUES);
+
+    QTest::newRow("Set meta values in default constructed data") << Setup::Empty << int64_t(1) << QVector<char>{-1, -2, -3, -4, -5};
+    QTest::newRow("Set meta values in data with values should overwrite existing values") << Setup::Data << int64_t(1) << QVector<char>{1, 2, 3, 4, 5};
+}
+
+void PagedDataTest::setMetaValue()
+{
+    QFETCH(int64_t, index);
+    QFETCH(char, value);
+
+    mData.setMetaValue(index, value);
+
+    QCOMPARE(*mData.metaData(index, 1), value);
+}
+
+void PagedDataTest::setMetaValue_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<char>(VALUE);
+
+    QTest::newRow("Set meta value in default constructed data") << Setup::Empty << int64_t(1) << char(-1);
+    QTest::newRow("Set meta value in data with values should overwrite existing value") << Setup::Data << int64_t(1) << char(1);
+}
+
+void PagedDataTest::setValue()
+{
+    QFETCH(int64_t, index);
+    QFETCH(int, value);
+
+    mData.setValue(index, value);
+
+    QCOMPARE(mData.value(index), value);
+}
+
+void PagedDataTest::setValue_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<int>(VALUE);
+
+    QTest::newRow("Set value in default constructed data") << Setup::Empty << int64_t(1) << -100;
+    QTest::newRow("Set value in data with values overwrites the existing value") << Setup::Data << int64_t(1) << -100;
+}
+
+void PagedDataTest::value()
+{
+    QFETCH(int64_t, index);
+
+    QTEST(mData.value(index), VALUE);
+}
+
+void PagedDataTest::value_data()
+{
+    QTest::addColumn<Setup>(SETUP);
+    QTest::addColumn<int64_t>(INDEX);
+    QTest::addColumn<int>(VALUE);
+
+    QTest::newRow("Value of default constructed data should have default value") << Setup::Empty << int64_t(1) << 0;
+    QTest::newRow("Value of data with values should have correct value") << Setup::Data << int64_t(1) << 11;
+}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <PagedData.h>
+#include <QObject>
+#include <QVector>
+
+namespace adb
+{
+class PagedDataTest : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Setup
+    {
+        None,
+        Empty,
+        Data
+    };
+
+    struct Node
+    {
+        int key = 0;
+        int value = 0;
+    };
+
+    static constexpr int64_t PAGE_SIZE = 64;
+    static constexpr int64_t CACHE_SIZE = PAGE_SIZE * 4;
+    static constexpr const char *FILE_NAME = "PagedDataTest.data";
+
+    using QObject::QObject;
+
+    static QVector<Node> createValues();
+    static QVector<char> createMetaValues();
+
+private slots:
+    void init();
+
+    void cacheSize();
+    void cacheSize_data();
+    void count();
+    void count_data();
+    void dataSize();
+    void dataSize_data();
+    void deletedCount();
+    void deletedCount_data();
+    void hash();
+    void hash_data();
+    void key();
+    void key_data();
+    void memoryUsage();
+    void memoryUsage_data();
+    void metaData();
+    void metaData_data();
+    void metaDataAlignment();
+    void metaDataAlignment_data();
+    void metaSize();
+    void metaSize_data();
+    void move();
+    void move_data();
+    void resize();
+    void resize_data();
+    void setCount();
+    void setCount_data();
+    void setData();
+    void setData_data();
+    void setDeletedCount();
+    void setDeletedCount_data();
+    void setMetaData();
+    void setMetaData_data();
+    void setMetaValue();
+    void setMetaValue_data();
+    void setValue();
+    void setValue_data();
+    void value();
+    void value_data();
+
+private:
+    PagedData<int, int, PAGE_SIZE> mData = PagedData<int, int, PAGE_SIZE>(0, 0, 0, FILE_NAME, CACHE_SIZE);
+};
+}
@@ -0,0 +1,173 @@
+#include "StaticHashTest.h"
+
+#include <QTest>
+#include <StaticHash.h>
+#include <TestExtras.h>
+#include <cstring>
+
+QTEST_APPLESS_MAIN(adb::StaticHashTest)
+
+namespace adb
+{
+namespace
+{
+constexpr auto STATUS = makeStaticHash<int, StaticHashTest::Code>({{200, StaticHashTest::Code::Ok}, {404, StaticHashTest::Code::NotFound}, {410, StaticHashTest::Code::NotFound}, {500, StaticHashTest::Code::Error}, {503, StaticHashTest::Code::Error}});
+constexpr auto NAMES = makeStaticHash<const char *, int>({{"zero", 0}, {"one", 1}, {"two", 2}, {"three", 3}, {"four", 4}, {"five", 5}, {"six", 6}, {"seven", 7}, {"eight", 8}, {"nine", 9}});
+
+template<typename Key, int Size>
+struct Sequence
+{
+    constexpr Sequence() :
+        entries()
+    {
+        for(int i = 0; i < Size; i++)
+            entries[i] = {static_cast<Key>(i) * 4096, i};
+    }
+
+    StaticEntry<Key, int> entries[Size];
+};
+
+constexpr Sequence<int, 300> SEQUENCE;
+constexpr StaticHash<int, int, 300> STRIDED(SEQUENCE.entries);
+constexpr Sequence<int64_t, 1000> LARGE_SEQUENCE;
+constexpr StaticHash<int64_t, int, 1000> LARGE(LARGE_SEQUENCE.entries);
+
+static_assert(STATUS.contains(404), "Lookups should be evaluated at compile time");
+static_assert(STATUS.value(503) == StaticHashTest::Code::Error, "Lookups should be evaluated at compile time");
+static_assert(NAMES.value("seven") == 7, "String keys should be compared by content at compile time");
+static_assert(STRIDED.value(299 * 4096, -1) == 299, "Patterned keys should be placed without collisions");
+static_assert(LARGE.value(int64_t(999) * 4096, -1) == 999, "Large tables should be built at compile time");
+}
+
+void StaticHashTest::contains()
+{
+    QFETCH(qint64, key);
+
+    QTEST(STATUS.contains(static_cast<int>(key)), RESULT);
+}
+
+void StaticHashTest::contains_data()
+{
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<bool>(RESULT);
+
+    QTest::newRow("Existing key should be found") << qint64(410) << true;
+    QTest::newRow("Missing key should not be found") << qint64(403) << false;
+    QTest::newRow("Missing key in occupied slot should not be found") << qint64(0) << false;
+}
+
+void StaticHashTest::count()
+{
+    QCOMPARE(STATUS.count(), qint64(5));
+    QCOMPARE(NAMES.count(), qint64(10));
+    QCOMPARE(STRIDED.count(), qint64(300));
+    QCOMPARE(LARGE.count(), qint64(1000));
+}
+
+void StaticHashTest::count_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Count should be the number of entries") << qint64(0);
+}
+
+void StaticHashTest::find()
+{
+    QFETCH(qint64, count);
+
+    for(int i = 0; i < count; i++)
+    {
+        const auto it = STRIDED.find(i * 4096);
+
+        QVERIFY(it != STRIDED.end());
+        QCOMPARE(it->key, i * 4096);
+        QCOMPARE(it->value, i);
+        QVERIFY(STRIDED.find(i * 4096 + 1) == STRIDED.end());
+    }
+}
+
+void StaticHashTest::find_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Every key should be found in its single slot") << qint64(300);
+}
+
+void StaticHashTest::find_large()
+{
+    QFETCH(qint64, count);
+
+    for(qint64 i = 0; i < count; i++)
+    {
+        const auto it = LARGE.find(i * 4096);
+
+        QVERIFY(it != LARGE.end());
+        QCOMPARE(it->value, static_cast<int>(i));
+        QVERIFY(LARGE.find(i * 4096 + 1) == LARGE.end());
+    }
+}
+
+void StaticHashTest::find_large_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Every key of a large table should be found") << qint64(1000);
+}
+
+void StaticHashTest::iterator()
+{
+    QFETCH(qint64, count);
+
+    qint64 sum = 0;
+
+    for(const StaticEntry<const char *, int> &entry : NAMES)
+        sum += entry.value;
+
+    QCOMPARE(sum, count);
+    QCOMPARE(std::strcmp(NAMES.begin()->key, "zero"), 0);
+}
+
+void StaticHashTest::iterator_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Iteration should visit all entries in declaration order") << qint64(45);
+}
+
+void StaticHashTest::value()
+{
+    QFETCH(qint64, key);
+    QFETCH(int, value);
+
+    QCOMPARE(static_cast<int>(STATUS.value(static_cast<int>(key), Code::Ok)), value);
+}
+
+void StaticHashTest::value_data()
+{
+    QTest::addColumn<qint64>(KEY);
+    QTest::addColumn<int>(VALUE);
+
+    QTest::newRow("Value of existing key should be returned") << qint64(404) << static_cast<int>(Code::NotFound);
+    QTest::newRow("Default value should be returned for missing key") << qint64(201) << static_cast<int>(Code::Ok);
+}
+
+void StaticHashTest::value_string()
+{
+    QFETCH(QString, key);
+    QFETCH(int, value);
+
+    const std::string name = key.toStdString();
+
+    QCOMPARE(NAMES.value(name.c_str(), -1), value);
+}
+
+void StaticHashTest::value_string_data()
+{
+    QTest::addColumn<QString>(KEY);
+    QTest::addColumn<int>(VALUE);
+
+    QTest::newRow("String key should be compared by content") << QString("three") << 3;
+    QTest::newRow("Prefix of a key should not be found") << QString("thr") << -1;
+    QTest::newRow("Empty string should not be found") << QString("") << -1;
+}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QObject>
+
+namespace adb
+{
+class StaticHashTest : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Code
+    {
+        Ok,
+        NotFound,
+        Error
+    };
+
+    using QObject::QObject;
+
+private slots:
+    void contains();
+    void contains_data();
+    void count();
+    void count_data();
+    void find();
+    void find_data();
+    void find_large();
+    void find_large_data();
+    void iterator();
+    void iterator_data();
+    void value();
+    void value_data();
+    void value_string();
+    void value_string_data();
+};
+}
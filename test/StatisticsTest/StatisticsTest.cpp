@@ -0,0 +1,230 @@
+#include "StatisticsTest.h"
+
+#include <QTest>
+#include <TestExtras.h>
+
+QTEST_APPLESS_MAIN(adb::StatisticsTest)
+
+namespace adb
+{
+namespace
+{
+constexpr char SHIFT[] = "shift";
+}
+
+void StatisticsTest::init()
+{
+    QFETCH(qint64, count);
+
+    mHash = decltype(mHash)();
+
+    for(qint64 key = 0; key < count; key++)
+        mHash.insert(key, key);
+
+    mHash.resetStats();
+}
+
+void StatisticsTest::falsePositiveRate()
+{
+    Statistics statistics;
+    statistics.tagMatches = 8;
+    statistics.tagFalsePositives = 2;
+
+    QCOMPARE(statistics.falsePositiveRate(), 0.25);
+    QCOMPARE(Statistics().falsePositiveRate(), 0.0);
+}
+
+void StatisticsTest::falsePositiveRate_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("False positive rate should be ratio of false positives to all tag matches") << qint64(0);
+}
+
+void StatisticsTest::fullGroupRatio()
+{
+    Statistics statistics;
+    statistics.probedGroups = 4;
+    statistics.fullGroups = 1;
+
+    QCOMPARE(statistics.fullGroupRatio(), 0.25);
+    QCOMPARE(Statistics().fullGroupRatio(), 0.0);
+}
+
+void StatisticsTest::fullGroupRatio_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Full group ratio should be ratio of full groups to all probed groups") << qint64(0);
+}
+
+void StatisticsTest::lookups()
+{
+    QFETCH(qint64, count);
+
+    for(qint64 key = 0; key < count * 2; key++)
+        mHash.contains(key);
+
+    const Statistics statistics = mHash.stats();
+
+    QCOMPARE(statistics.lookups, count * 2);
+    QVERIFY(statistics.lookupGroups >= statistics.lookups);
+    QVERIFY(statistics.maxLookupGroups >= 1);
+    QVERIFY(statistics.probedGroups >= statistics.lookupGroups);
+    QVERIFY(statistics.tagMatches - statistics.tagFalsePositives == count);
+    QCOMPARE(statistics.inserts, qint64(0));
+}
+
+void StatisticsTest::lookups_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Every lookup should be counted and every hit should be a true tag match") << qint64(100);
+}
+
+void StatisticsTest::inserts()
+{
+    QFETCH(qint64, count);
+
+    for(qint64 key = 0; key < count; key++)
+        mHash.insert(key + count, key);
+
+    const Statistics statistics = mHash.stats();
+
+    QCOMPARE(statistics.inserts, count);
+    QVERIFY(statistics.insertGroups >= statistics.inserts);
+    QVERIFY(statistics.maxInsertGroups >= 1);
+    QCOMPARE(statistics.lookups, qint64(0));
+    QCOMPARE(statistics.count, count * 2);
+    QVERIFY(statistics.capacity >= statistics.count);
+    QCOMPARE(statistics.loadFactor, static_cast<double>(count * 2) / statistics.capacity);
+}
+
+void StatisticsTest::inserts_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Every insert should be counted once") << qint64(100);
+}
+
+void StatisticsTest::rehashes()
+{
+    QFETCH(qint64, count);
+
+    for(qint64 key = count; key < count * 2; key++)
+        mHash.insert(key, key);
+
+    QVERIFY(mHash.stats().grows > 0);
+
+    for(qint64 key = 0; key < count * 2; key++)
+        mHash.remove(key);
+
+    QVERIFY(mHash.stats().shrinks > 0);
+
+    const auto clustered = [](qint64 key) { return key / 32 * 16 + key % 32 * 4096; };
+
+    for(qint64 key = 0; key < count; key++)
+        mHash.insert(clustered(key), key);
+
+    mHash.resetStats();
+
+    for(qint64 key = 0; key < count * 100; key++)
+    {
+        mHash.remove(clustered(key));
+        mHash.insert(clustered(key + count), key);
+    }
+
+    QCOMPARE(mHash.stats().grows, qint64(0));
+
+    QVERIFY(mHash.stats().cleanups > 0);
+}
+
+void StatisticsTest::rehashes_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Growing, shrinking and tombstone cleanups should be counted") << qint64(100);
+}
+
+void StatisticsTest::resetStats()
+{
+    QFETCH(qint64, count);
+
+    mHash.contains(0);
+    mHash.insert(count, count);
+    mHash.resetStats();
+
+    const Statistics statistics = mHash.stats();
+
+    QCOMPARE(statistics.lookups, qint64(0));
+    QCOMPARE(statistics.inserts, qint64(0));
+    QCOMPARE(statistics.probedGroups, qint64(0));
+    QCOMPARE(statistics.count, count + 1);
+}
+
+void StatisticsTest::resetStats_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+
+    QTest::newRow("Resetting statistics should clear counters but not the snapshot") << qint64(10);
+}
+
+void StatisticsTest::tombstones()
+{
+    QFETCH(qint64, size);
+
+    for(qint64 key = 0; key < size; key++)
+        mHash.remove(key);
+
+    const Statistics statistics = mHash.stats();
+
+    QCOMPARE(statistics.deletedCount, qint64(0));
+    QCOMPARE(statistics.lookups, size);
+    QCOMPARE(statistics.lookupGroups, size);
+    QCOMPARE(statistics.shrinks, qint64(0));
+    QCOMPARE(statistics.cleanups, qint64(0));
+}
+
+void StatisticsTest::tombstones_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<qint64>(SIZE);
+
+    QTest::newRow("Removing from full groups no key overflowed should leave no tombstones") << qint64(112) << qint64(16);
+}
+
+void StatisticsTest::wideTags()
+{
+    QFETCH(qint64, count);
+    QFETCH(int, shift);
+
+    for(qint64 key = 1; key <= count; key++)
+        mHash.insert(key << shift, key);
+
+    mHash.resetStats();
+
+    for(qint64 key = 1; key <= count; key++)
+        mHash.contains(key << shift);
+
+    QCOMPARE(mHash.stats().tagMatches - mHash.stats().tagFalsePositives, count);
+    QVERIFY(mHash.stats().tagFalsePositives > 0);
+
+    mHash.setWideTags(true);
+    mHash.resetStats();
+
+    for(qint64 key = 1; key <= count; key++)
+        mHash.contains(key << shift);
+
+    QCOMPARE(mHash.stats().tagMatches, count);
+    QCOMPARE(mHash.stats().tagFalsePositives, qint64(0));
+}
+
+void StatisticsTest::wideTags_data()
+{
+    QTest::addColumn<qint64>(COUNT);
+    QTest::addColumn<int>(SHIFT);
+
+    QTest::newRow("Wide tags should filter out keys sharing the meta value before comparing them") << qint64(100) << 48;
+    QTest::newRow("Wide tags should filter out keys below 2^48 sharing the meta value") << qint64(100) << 16;
+}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#define ADB_STATISTICS
+
+#include <ADbHash.h>
+#include <QObject>
+
+namespace adb
+{
+class StatisticsTest : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+private slots:
+    void init();
+
+    void falsePositiveRate();
+    void falsePositiveRate_data();
+    void fullGroupRatio();
+    void fullGroupRatio_data();
+    void lookups();
+    void lookups_data();
+    void inserts();
+    void inserts_data();
+    void rehashes();
+    void rehashes_data();
+    void resetStats();
+    void resetStats_data();
+    void tombstones();
+    void tombstones_data();
+    void wideTags();
+    void wideTags_data();
+
+private:
+    ADbHash<qint64, qint64> mHash;
+};
+}